@@ -0,0 +1,28 @@
+#include "bench.h"
+
+namespace interp::bench
+{
+	void arrays()
+	{
+		// One push per call onto an array that grows to 1M elements
+		compare_engines("array build (1M)", R"(
+let build = fn(n, arr) { if (n == 0) { arr } else { build(n - 1, push(arr, n)) } };
+len(build(1000000, []));
+)", "1000000", 1000000, "pushes");
+
+		// One index per call
+		compare_engines("array scan by index (1M)", R"(
+let build = fn(n, arr) { if (n == 0) { arr } else { build(n - 1, push(arr, n)) } };
+let arr = build(1000000, []);
+let sum = fn(i, acc) { if (i == len(arr)) { acc } else { sum(i + 1, acc + arr[i]) } };
+sum(0, 0);
+)", "500000500000", 2000000, "calls");
+
+		// One first and one rest per call, rest sharing the array's storage
+		compare_engines("array scan by rest (1M)", R"(
+let build = fn(n, arr) { if (n == 0) { arr } else { build(n - 1, push(arr, n)) } };
+let sum = fn(arr, acc) { if (len(arr) == 0) { acc } else { sum(rest(arr), acc + first(arr)) } };
+sum(build(1000000, []), 0);
+)", "500000500000", 2000000, "calls");
+	}
+}
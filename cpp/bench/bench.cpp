@@ -0,0 +1,22 @@
+#include <iomanip>
+
+#include "bench.h"
+
+namespace interp::bench
+{
+	Timer::Timer() : start(std::chrono::steady_clock::now())
+	{
+	}
+
+	double Timer::elapsed() const
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start).count();
+	}
+
+	void report(const std::string& name, double seconds, double items, const std::string& unit)
+	{
+		std::cout << std::left << std::setw(32) << name
+			<< std::right << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000 << " ms"
+			<< std::setw(16) << std::setprecision(0) << items / seconds << " " << unit << "/s\n";
+	}
+}
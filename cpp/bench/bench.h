@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace interp::bench
+{
+	class Timer
+	{
+	public:
+		Timer();
+		~Timer() = default;
+
+		double elapsed() const;
+
+	private:
+		std::chrono::steady_clock::time_point start;
+	};
+
+	// Runs fn repeatedly until at least min_seconds have passed and returns the
+	// best time of a single run in seconds.
+	template <typename Fn>
+	double best_of(Fn fn, double min_seconds = 1.0)
+	{
+		double best = -1;
+		Timer total;
+		do
+		{
+			Timer run;
+			fn();
+			double elapsed = run.elapsed();
+			if (best < 0 || elapsed < best)
+				best = elapsed;
+		} while (total.elapsed() < min_seconds);
+		return best;
+	}
+
+	void report(const std::string& name, double seconds, double items, const std::string& unit);
+	// Runs script on every engine, see engines_bench.cpp
+	void compare_engines(const std::string& name, const std::string& script, const std::string& expected, double work, const std::string& unit);
+
+	void lexer_parser();
+	void evaluator();
+	void engines();
+	void nursery();
+	void refcount();
+	void arrays();
+	void hashes();
+	void loops();
+}
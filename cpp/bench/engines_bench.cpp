@@ -0,0 +1,109 @@
+#include "bench.h"
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+#include "parser/eval.h"
+#include "parser/stack_eval.h"
+#include "parser/vm/vm.h"
+
+namespace interp::bench
+{
+	typedef interp::object::Value (*EngineFn)(interp::ast::Program*, interp::object::Ref<interp::object::Environment>&);
+
+	interp::object::Value run_tree(interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env)
+	{
+		return interp::eval::eval(program, env);
+	}
+
+	// Runs script on every engine and reports each one's cost per unit of
+	// work, after checking it produces expected. Both include their passes
+	// over the AST (resolving, compiling) but not parsing.
+	void compare_engines(const std::string& name, const std::string& script, const std::string& expected, double work, const std::string& unit)
+	{
+		const std::pair<const char*, EngineFn> engines[] = {
+			{"tree", run_tree},
+			{"vm", interp::vm::run},
+			{"stack", interp::eval::eval_on_heap},
+		};
+
+		auto lex = interp::lexer::Lexer::borrow(script);
+		interp::parser::Parser parse(lex);
+		auto prog = parse.parse_program();
+
+		for (auto& [engine, engine_fn] : engines)
+		{
+			auto run = [&]
+			{
+				auto env = interp::object::Environment::new_env(nullptr);
+				return engine_fn(prog.get(), env);
+			};
+
+			auto label = name + " (" + engine + ")";
+			auto result = run();
+			if (!result || result.inspect() != expected)
+			{
+				std::cout << label << ": expected " << expected << " got " << (result ? result.inspect() : "nothing") << '\n';
+				continue;
+			}
+
+			double time = best_of(run);
+			report(label, time, work, unit);
+		}
+	}
+
+	void engines()
+	{
+		// fib(25) makes 242785 calls
+		compare_engines("fib(25)", R"(
+let fib = fn(x) {
+	if (x < 2) { x } else { fib(x - 1) + fib(x - 2) }
+};
+fib(25);
+)", "75025", 242785, "calls");
+
+		// Non-tail recursion, 2 calls per level
+		compare_engines("recursive sum", R"(
+let sum = fn(n) { if (n == 0) { 0 } else { n + sum(n - 1) } };
+let repeat = fn(i, acc) { if (i == 0) { acc } else { repeat(i - 1, acc + sum(1000)) } };
+repeat(100, 0);
+)", "50050000", 100 * 1001.0, "calls");
+
+		// 6 infix operations per call
+		compare_engines("arithmetic loop", R"(
+let step = fn(n, acc) {
+	if (n == 0) { acc } else { step(n - 1, acc + n * 3 - n / 2 - 1) }
+};
+let outer = fn(i, acc) {
+	if (i == 0) { acc } else { outer(i - 1, acc + step(100, 0)) }
+};
+outer(200, 0);
+)", "2510000", 200 * 100 * 6.0, "ops");
+
+		// Closure creation and calls through captured variables, 3 calls per step
+		compare_engines("closures", R"(
+let compose = fn(f, g) { fn(x) { g(f(x)) } };
+let inc = fn(x) { x + 1 };
+let double = fn(x) { x * 2 };
+let loop = fn(n, acc) {
+	if (n == 0) { acc } else { loop(n - 1, compose(inc, double)(acc) - acc - 1) }
+};
+loop(2000, 0);
+)", "2000", 2000 * 3.0, "calls");
+
+		// 20000 appends to a string that grows to 200KB
+		std::string built;
+		for (int i = 0; i < 20000; i++)
+		{
+			built += "0123456789";
+		}
+		compare_engines("string building", R"(
+let build = fn(n, s) { if (n == 0) { s } else { build(n - 1, s + "0123456789") } };
+build(20000, "");
+)", built, 20000, "appends");
+
+		// Native calls, 1 builtin call per step
+		compare_engines("builtin calls", R"(
+let count = fn(n, acc) { if (n == 0) { acc } else { count(n - 1, acc + len("abc")) } };
+count(100000, 0);
+)", "300000", 100000, "calls");
+	}
+}
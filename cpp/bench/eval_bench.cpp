@@ -0,0 +1,65 @@
+#include "bench.h"
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+#include "parser/eval.h"
+
+namespace interp::bench
+{
+	// Evaluates script and reports its cost per unit of work, after checking
+	// it produces expected. Parsing is not part of the measurement.
+	void report_script(const std::string& name, const std::string& script, const std::string& expected, double work, const std::string& unit)
+	{
+		auto lex = interp::lexer::Lexer::borrow(script);
+		interp::parser::Parser parse(lex);
+		auto prog = parse.parse_program();
+
+		auto run = [&]
+		{
+			auto env = interp::object::Environment::new_env(nullptr);
+			return interp::eval::eval(prog.get(), env);
+		};
+
+		auto result = run();
+		if (!result || result.inspect() != expected)
+		{
+			std::cout << name << ": expected " << expected << " got " << (result ? result.inspect() : "nothing") << '\n';
+			return;
+		}
+
+		double time = best_of(run);
+		report(name, time, work, unit);
+	}
+
+	void evaluator()
+	{
+		// fib(25) makes 242785 calls
+		report_script("fib(25)", R"(
+let fib = fn(x) {
+	if (x < 2) { x } else { fib(x - 1) + fib(x - 2) }
+};
+fib(25);
+)", "75025", 242785, "calls");
+
+		// Straight line arithmetic, 9 infix operations per statement
+		std::string arithmetic;
+		size_t statements = 20000;
+		arithmetic += "let x = 1;\n";
+		for (size_t i = 0; i < statements; i++)
+		{
+			arithmetic += "let x = (x * 3 + 7 - 2 * 4) / 2 - x + (10 - 4) / 3;\n";
+		}
+		arithmetic += "x;\n";
+		report_script("arithmetic", arithmetic, "2", statements * 9.0, "ops");
+
+		// Arithmetic inside a shallow recursive loop, 6 infix operations per call
+		report_script("arithmetic loop", R"(
+let step = fn(n, acc) {
+	if (n == 0) { acc } else { step(n - 1, acc + n * 3 - n / 2 - 1) }
+};
+let outer = fn(i, acc) {
+	if (i == 0) { acc } else { outer(i - 1, acc + step(100, 0)) }
+};
+outer(200, 0);
+)", "2510000", 200 * 100 * 6.0, "ops");
+	}
+}
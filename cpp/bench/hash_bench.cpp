@@ -0,0 +1,71 @@
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "parser/object.h"
+
+namespace interp::bench
+{
+	// Sums the values found for keys, which all have to be present
+	template <typename Lookup>
+	int64_t sum_lookups(const std::vector<interp::object::Value>& keys, Lookup lookup)
+	{
+		int64_t sum = 0;
+		for (auto& key : keys)
+		{
+			sum += lookup(key).as_integer();
+		}
+		return sum;
+	}
+
+	void hashes()
+	{
+		const size_t size = 100000;
+		const size_t lookups = 1000000;
+
+		std::vector<interp::object::Value> int_pairs;
+		std::vector<interp::object::Value> string_pairs;
+		std::unordered_map<int64_t, interp::object::Value> baseline;
+		for (size_t i = 0; i < size; i++)
+		{
+			auto value = interp::object::Value::integer(static_cast<int64_t>(i));
+			int_pairs.push_back(interp::object::Value::integer(static_cast<int64_t>(i * 7919)));
+			int_pairs.push_back(value);
+			string_pairs.push_back(interp::object::make_ref<interp::object::StringObject>("/route/" + std::to_string(i)));
+			string_pairs.push_back(value);
+			baseline[static_cast<int64_t>(i * 7919)] = value;
+		}
+		interp::object::HashObject int_hash(int_pairs);
+		interp::object::HashObject string_hash(string_pairs);
+
+		// Keys in random order so lookups miss the cache as a real table would
+		std::mt19937 random(42);
+		std::uniform_int_distribution<size_t> pick(0, size - 1);
+		std::vector<interp::object::Value> int_keys;
+		std::vector<interp::object::Value> string_keys;
+		for (size_t i = 0; i < lookups; i++)
+		{
+			auto index = pick(random);
+			int_keys.push_back(int_pairs[index * 2]);
+			string_keys.push_back(string_pairs[index * 2]);
+		}
+
+		report("integer keys (unordered_map)", best_of([&]
+			{ return sum_lookups(int_keys, [&](const interp::object::Value& key) { return baseline.find(key.as_integer())->second; }); }),
+			lookups, "lookups");
+		report("integer keys (HashObject)", best_of([&]
+			{ return sum_lookups(int_keys, [&](const interp::object::Value& key) { return *int_hash.get(key); }); }),
+			lookups, "lookups");
+		report("string keys (HashObject)", best_of([&]
+			{ return sum_lookups(string_keys, [&](const interp::object::Value& key) { return *string_hash.get(key); }); }),
+			lookups, "lookups");
+
+		// One lookup with a constant string key per call
+		compare_engines("routing table", R"(
+let routes = {"/": 1, "/users": 2, "/users/new": 3, "/posts": 4, "/posts/new": 5, "/about": 6};
+let count = fn(n, acc) { if (n == 0) { acc } else { count(n - 1, acc + routes["/posts/new"]) } };
+count(100000, 0);
+)", "500000", 100000, "lookups");
+	}
+}
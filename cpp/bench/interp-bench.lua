@@ -0,0 +1,11 @@
+project "interp-bench"
+	kind "ConsoleApp"
+	targetdir "%{outputdir}/bench"
+	objdir "%{interdir}/bench"
+	staticruntime "off"
+
+	files { "**.cpp" }
+
+	includedirs { "./", "%{maindir}/src/", "%{maindir}/src/parser/" }
+
+	links { "interp-lexer", "interp-parser" }
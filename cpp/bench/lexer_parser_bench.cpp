@@ -0,0 +1,93 @@
+#include "bench.h"
+#include "lexer/scan.h"
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+
+namespace interp::bench
+{
+	std::string lexer_parser_script(size_t copies)
+	{
+		std::string chunk = R"(let fibonacci = fn(x) {
+	if (x <= 1) {
+		return x;
+	} else {
+		return fibonacci(x - 1) + fibonacci(x - 2);
+	}
+};
+let greeting = "hello " + "world";
+let result = fibonacci(10) * 2 + -5 / (3 - 1);
+let check = !(result >= 100) == false;
+let make_adder = fn(a, b) { fn(c) { a + b + c } };
+)";
+		std::string script;
+		script.reserve(chunk.size() * copies);
+		for (size_t i = 0; i < copies; i++)
+		{
+			script += chunk;
+		}
+		return script;
+	}
+
+	void report_spans(const std::string& name, const std::string& script)
+	{
+		auto initial = interp::lexer::scan::active_isa();
+
+		for (auto isa : {interp::lexer::scan::Isa::Scalar, interp::lexer::scan::Isa::SSE2, interp::lexer::scan::Isa::AVX2})
+		{
+			if (!interp::lexer::scan::set_isa(isa))
+				continue;
+
+			double time = best_of([&]
+			{
+				auto lex = interp::lexer::Lexer::borrow(script);
+				while (lex.next_span_token().type != interp::token::L_EOF)
+				{
+				}
+			});
+
+			report(name + " [" + interp::lexer::scan::isa_to_string(isa) + "]", time, script.size() / (1024.0 * 1024.0), "MiB");
+		}
+
+		interp::lexer::scan::set_isa(initial);
+	}
+
+	void lexer_parser()
+	{
+		auto script = lexer_parser_script(20000);
+
+		size_t tokens = 0;
+		double lex_time = best_of([&]
+		{
+			interp::lexer::Lexer lex(script);
+			tokens = 0;
+			while (lex.next_token().type != interp::token::L_EOF)
+			{
+				tokens++;
+			}
+		});
+
+		size_t statements = 0;
+		double parse_time = best_of([&]
+		{
+			interp::lexer::Lexer lex(script);
+			interp::parser::Parser parse(lex);
+			statements = parse.parse_program()->statements.size();
+		});
+
+		std::cout << script.size() / 1024 << " KiB, " << tokens << " tokens, " << statements << " statements\n";
+		report("lex", lex_time, tokens, "tokens");
+		report("lex + parse", parse_time, tokens, "tokens");
+
+		// Generated configuration style input: deep indentation and long strings
+		std::string config;
+		for (size_t i = 0; i < 20000; i++)
+		{
+			config += std::string(4 * (i % 12), ' ') + "let setting_value = \"" + std::string(200, 'x') + "\";\n";
+			config += std::string(4 * (i % 12), '\t') + "let some_long_identifier_name = 1234567890123456;\n";
+		}
+
+		std::cout << "\n" << config.size() / 1024 << " KiB of configuration\n";
+		report_spans("lex spans", script);
+		report_spans("lex spans (config)", config);
+	}
+}
@@ -0,0 +1,30 @@
+#include "bench.h"
+
+namespace interp::bench
+{
+	void loops()
+	{
+		// The same 10M iterations as a while loop, which reuses one
+		// environment, and as tail calls, which make one per call
+		compare_engines("while loop (10M)", R"(
+let i = 0;
+let sum = 0;
+while (i < 10000000) { sum = sum + i; i = i + 1 };
+sum;
+)", "49999995000000", 10000000, "iterations");
+
+		compare_engines("tail recursion (10M)", R"(
+let loop = fn(i, sum) { if (i < 10000000) { loop(i + 1, sum + i) } else { sum } };
+loop(0, 0);
+)", "49999995000000", 10000000, "iterations");
+
+		// The body makes a closure, so every iteration gets an environment
+		compare_engines("capturing for loop (1M)", R"(
+let build = fn(n, arr) { if (n == 0) { arr } else { build(n - 1, push(arr, n)) } };
+let arr = build(1000000, []);
+let sum = 0;
+for (x in arr) { let f = fn() { x }; sum = sum + f() };
+sum;
+)", "500000500000", 1000000, "iterations");
+	}
+}
@@ -0,0 +1,40 @@
+#include <cstring>
+#include <iostream>
+
+#include "bench.h"
+
+struct Benchmark
+{
+	const char* name;
+	void (*run)();
+};
+
+const Benchmark benchmarks[] = {
+	{"lexer_parser", interp::bench::lexer_parser},
+	{"eval", interp::bench::evaluator},
+	{"engines", interp::bench::engines},
+	{"nursery", interp::bench::nursery},
+	{"refcount", interp::bench::refcount},
+	{"arrays", interp::bench::arrays},
+	{"hashes", interp::bench::hashes},
+	{"loops", interp::bench::loops},
+};
+
+int main(int argc, char** argv)
+{
+	for (auto& benchmark : benchmarks)
+	{
+		bool selected = argc < 2;
+		for (int i = 1; i < argc; i++)
+		{
+			if (std::strcmp(argv[i], benchmark.name) == 0)
+				selected = true;
+		}
+
+		if (selected)
+		{
+			std::cout << "== " << benchmark.name << '\n';
+			benchmark.run();
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#include "bench.h"
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+#include "parser/eval.h"
+
+namespace interp::bench
+{
+	// Tail calls and returns make a short-lived object each, a third of the
+	// strings made are kept until the next step
+	const char* const nursery_script = R"(
+let step = fn(n, kept) {
+	if (n == 0) { return kept; }
+	let s = "a" + "b";
+	step(n - 1, if (n / 3 * 3 == n) { s } else { kept })
+};
+step(100000, "");
+)";
+
+	void nursery()
+	{
+		auto lex = interp::lexer::Lexer::borrow(nursery_script);
+		interp::parser::Parser parse(lex);
+		auto prog = parse.parse_program();
+
+		auto default_size = interp::object::nursery::size();
+		for (size_t size : {4 * 1024, 64 * 1024, 1024 * 1024})
+		{
+			interp::object::nursery::set_size(size);
+			auto run = [&]
+			{
+				auto env = interp::object::Environment::new_env(nullptr);
+				return interp::eval::eval(prog.get(), env);
+			};
+
+			run();
+			interp::object::nursery::reset_stats();
+			run();
+			auto stats = interp::object::nursery::stats();
+
+			auto label = "nursery " + std::to_string(size / 1024) + "K";
+			report(label, best_of(run), 100000, "steps");
+			std::cout << "  hits " << stats.hits << ", misses " << stats.misses
+				<< ", promotions " << stats.promotions << ", pauses " << stats.pauses
+				<< " (" << stats.pause_ns / 1000 << " us)\n";
+		}
+		interp::object::nursery::set_size(default_size);
+	}
+}
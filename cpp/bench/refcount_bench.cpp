@@ -0,0 +1,63 @@
+#include <memory>
+
+#include "bench.h"
+#include "parser/object/ref.h"
+
+namespace interp::bench
+{
+	struct SharedNode
+	{
+		std::shared_ptr<SharedNode> left;
+		std::shared_ptr<SharedNode> right;
+		int64_t value;
+	};
+
+	struct RefNode : public interp::object::RefCounted
+	{
+		interp::object::Ref<RefNode> left;
+		interp::object::Ref<RefNode> right;
+		int64_t value;
+	};
+
+	template <typename Handle, typename Make>
+	Handle build_tree(Make make, int depth)
+	{
+		if (depth == 0)
+			return Handle();
+
+		auto node = make();
+		node->value = depth;
+		node->left = build_tree<Handle>(make, depth - 1);
+		node->right = build_tree<Handle>(make, depth - 1);
+		return node;
+	}
+
+	// Takes the handle by value like the evaluator used to, so every level
+	// pays for a count increment and decrement
+	template <typename Handle>
+	int64_t sum_tree(Handle node)
+	{
+		if (!node)
+			return 0;
+
+		return node->value + sum_tree(node->left) + sum_tree(node->right);
+	}
+
+	void refcount()
+	{
+		const int depth = 18;
+		const double nodes = (1 << depth) - 1;
+
+		auto shared_root = build_tree<std::shared_ptr<SharedNode>>([] { return std::make_shared<SharedNode>(); }, depth);
+		auto ref_root = build_tree<interp::object::Ref<RefNode>>([] { return interp::object::make_ref<RefNode>(); }, depth);
+
+		if (sum_tree(shared_root) != sum_tree(ref_root))
+		{
+			std::cout << "refcount: trees differ\n";
+			return;
+		}
+
+		report("recursive walk (shared_ptr)", best_of([&] { return sum_tree(shared_root); }), nodes, "nodes");
+		report("recursive walk (Ref)", best_of([&] { return sum_tree(ref_root); }), nodes, "nodes");
+	}
+}
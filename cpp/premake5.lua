@@ -35,4 +35,5 @@ filter "platforms:WinARM64"
 	architecture "ARM64"
 filter {}
 
-include "src/interp.lua"
\ No newline at end of file
+include "src/interp.lua"
+include "bench/interp-bench.lua"
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <mutex>
+#include <unordered_set>
+
+#include "atom.h"
+
+namespace interp::lexer
+{
+	struct AtomHash
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view text) const
+		{
+			return std::hash<std::string_view>()(text);
+		}
+	};
+
+	struct AtomTable
+	{
+		std::mutex lock;
+		// Nodes never move, so entries keep their address
+		std::unordered_set<std::string, AtomHash, std::equal_to<>> entries;
+
+		static AtomTable& get()
+		{
+			// Never destroyed, atoms may outlive static destructors
+			static auto table = new AtomTable();
+			return *table;
+		}
+	};
+
+	Atom::Atom()
+	{
+		static const Atom empty = intern("");
+		this->entry = empty.entry;
+	}
+
+	Atom intern(std::string_view text)
+	{
+		auto& table = AtomTable::get();
+		std::lock_guard<std::mutex> guard(table.lock);
+
+		auto found = table.entries.find(text);
+		if (found == table.entries.end())
+		{
+			found = table.entries.emplace(text).first;
+		}
+		return Atom(&*found);
+	}
+}
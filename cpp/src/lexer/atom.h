@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace interp::lexer
+{
+	// An interned string. Every atom made from the same text refers to the
+	// same table entry, so atoms compare and hash as pointers.
+	class Atom
+	{
+	public:
+		// The atom of the empty string
+		Atom();
+
+		const std::string& str() const
+		{
+			return *this->entry;
+		}
+
+		bool operator==(const Atom& other) const
+		{
+			return this->entry == other.entry;
+		}
+
+		struct Hash
+		{
+			size_t operator()(const Atom& atom) const
+			{
+				return std::hash<const void*>()(atom.entry);
+			}
+		};
+
+	private:
+		friend Atom intern(std::string_view text);
+
+		explicit Atom(const std::string* entry)
+			: entry(entry)
+		{
+		}
+
+		const std::string* entry;
+	};
+
+	// Returns the atom for text, adding it to the table the first time. The
+	// table is shared by every interpreter in the process and never shrinks.
+	Atom intern(std::string_view text);
+}
@@ -1,26 +1,55 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 #include "lexer.h"
+#include "scan.h"
 
-bool isLetter(char ch)
-{
-	return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
-}
-
-bool isDigit(char ch)
-{
-	return ch >= '0' && ch <= '9';
-}
+// Runs up to this long are scanned one character at a time
+constexpr size_t SHORT_RUN = 16;
 
 namespace interp::lexer
 {
 
-	Lexer::Lexer(std::string input) : input(input), position(0), read_position(0)
+	Lexer::Lexer(std::string input)
+		: Lexer(std::make_shared<const std::string>(std::move(input)), {})
+	{
+	}
+
+	Lexer::Lexer(std::shared_ptr<const std::string> owned, std::string_view input)
+		: owned(owned), input(owned ? std::string_view(*owned) : input), position(0), read_position(0)
 	{
+		if (this->input.size() > std::numeric_limits<uint32_t>::max())
+		{
+			throw std::length_error("lexer input is larger than 4 GiB");
+		}
+
 		this->read_char();
 	}
 
+	Lexer Lexer::borrow(std::string_view input)
+	{
+		return Lexer(nullptr, input);
+	}
+
 	interp::token::Token Lexer::next_token()
 	{
-		interp::token::Token tok;
+		return this->materialize(this->next_span_token());
+	}
+
+	std::string_view Lexer::text(interp::token::Span span) const
+	{
+		return this->input.substr(span.offset, span.length);
+	}
+
+	interp::token::Token Lexer::materialize(const interp::token::SpanToken& token) const
+	{
+		return {.type = token.type, .literal = std::string(this->text(token.span))};
+	}
+
+	interp::token::SpanToken Lexer::next_span_token()
+	{
+		interp::token::SpanToken tok;
 
 		this->skip_whitespace();
 
@@ -29,104 +58,113 @@ namespace interp::lexer
 		case '=':
 			if (this->peek_char() == '=')
 			{
-				char cur_ch = this->ch;
+				auto start = this->position;
 				this->read_char();
-				tok = {.type = interp::token::EQUAL, .literal = std::string(1, cur_ch) + std::string(1, this->ch)};
+				tok = this->new_token(interp::token::EQUAL, start);
 			}
 			else
 			{
-				tok = this->new_token(interp::token::ASSIGN, this->ch);
+				tok = this->new_token(interp::token::ASSIGN, this->position);
 			}
 			break;
 		case '+':
-			tok = this->new_token(interp::token::PLUS, this->ch);
+			tok = this->new_token(interp::token::PLUS, this->position);
 			break;
 		case '-':
-			tok = this->new_token(interp::token::MINUS, this->ch);
+			tok = this->new_token(interp::token::MINUS, this->position);
 			break;
 		case '*':
-			tok = this->new_token(interp::token::ASTERISK, this->ch);
+			tok = this->new_token(interp::token::ASTERISK, this->position);
 			break;
 		case '/':
-			tok = this->new_token(interp::token::FORWARDSLASH, this->ch);
+			tok = this->new_token(interp::token::FORWARDSLASH, this->position);
 			break;
 		case '!':
 			if (this->peek_char() == '=')
 			{
-				char cur_ch = this->ch;
+				auto start = this->position;
 				this->read_char();
-				tok = {.type = interp::token::NOTEQUAL, .literal = std::string(1, cur_ch) + std::string(1, this->ch)};
+				tok = this->new_token(interp::token::NOTEQUAL, start);
 			}
 			else
 			{
-				tok = this->new_token(interp::token::BANG, this->ch);
+				tok = this->new_token(interp::token::BANG, this->position);
 			}
 			break;
 		case '<':
 			if (this->peek_char() == '=')
 			{
-				char cur_ch = this->ch;
+				auto start = this->position;
 				this->read_char();
-				tok = {.type = interp::token::LESSTHANOREQUAL, .literal = std::string(1, cur_ch) + std::string(1, this->ch)};
+				tok = this->new_token(interp::token::LESSTHANOREQUAL, start);
 			}
 			else
 			{
-				tok = this->new_token(interp::token::LESSTHAN, this->ch);
+				tok = this->new_token(interp::token::LESSTHAN, this->position);
 			}
 			break;
 		case '>':
 			if (this->peek_char() == '=')
 			{
-				char cur_ch = this->ch;
+				auto start = this->position;
 				this->read_char();
-				tok = {.type = interp::token::GREATERTHANOREQUAL, .literal = std::string(1, cur_ch) + std::string(1, this->ch)};
+				tok = this->new_token(interp::token::GREATERTHANOREQUAL, start);
 			}
 			else
 			{
-				tok = this->new_token(interp::token::GREATERTHAN, this->ch);
+				tok = this->new_token(interp::token::GREATERTHAN, this->position);
 			}
 			break;
 		case ',':
-			tok = this->new_token(interp::token::COMMA, this->ch);
+			tok = this->new_token(interp::token::COMMA, this->position);
 			break;
 		case ';':
-			tok = this->new_token(interp::token::SEMICOLON, this->ch);
+			tok = this->new_token(interp::token::SEMICOLON, this->position);
+			break;
+		case ':':
+			tok = this->new_token(interp::token::COLON, this->position);
 			break;
 		case '(':
-			tok = this->new_token(interp::token::LPAREN, this->ch);
+			tok = this->new_token(interp::token::LPAREN, this->position);
 			break;
 		case ')':
-			tok = this->new_token(interp::token::RPAREN, this->ch);
+			tok = this->new_token(interp::token::RPAREN, this->position);
 			break;
 		case '{':
-			tok = this->new_token(interp::token::LBRACE, this->ch);
+			tok = this->new_token(interp::token::LBRACE, this->position);
 			break;
 		case '}':
-			tok = this->new_token(interp::token::RBRACE, this->ch);
+			tok = this->new_token(interp::token::RBRACE, this->position);
+			break;
+		case '[':
+			tok = this->new_token(interp::token::LBRACKET, this->position);
+			break;
+		case ']':
+			tok = this->new_token(interp::token::RBRACKET, this->position);
 			break;
 		case 0:
-			tok = {.type = interp::token::L_EOF, .literal = ""};
+			tok = {.type = interp::token::L_EOF, .span = {static_cast<uint32_t>(std::min(this->position, this->input.size())), 0}};
 			break;
 		case '"':
 		{
 			this->read_char();
-			std::string literal = this->read_until([](char ch) -> bool { return ch == '"'; });
-			tok = { .type = interp::token::STRING, .literal = literal };
+			auto span = this->scan_while<&scan::is_string_body>(&scan::skip_string_body);
+			tok = { .type = interp::token::STRING, .span = span };
 			break;
 		}
 		default:
-			if (isLetter(this->ch))
+			if (scan::is_letter(this->ch))
 			{
-				std::string literal = this->read_while(&isLetter);
-				return {.type = interp::token::lookup_ident(literal), .literal = literal};
+				auto span = this->scan_while<&scan::is_letter>(&scan::skip_letters);
+				return {.type = interp::token::lookup_ident(this->text(span)), .span = span};
 			}
-			else if (isDigit(this->ch))
+			else if (scan::is_digit(this->ch))
 			{
-				return {.type = interp::token::INT, .literal = this->read_while(&isDigit)};
+				return {.type = interp::token::INT, .span = this->scan_while<&scan::is_digit>(&scan::skip_digits)};
 			}
 			else
 			{
-				return this->new_token(interp::token::ILLEGAL, this->ch);
+				tok = this->new_token(interp::token::ILLEGAL, this->position);
 			}
 			break;
 		}
@@ -143,7 +181,7 @@ namespace interp::lexer
 		}
 		else
 		{
-			this->ch = this->input.at(this->read_position);
+			this->ch = this->input[this->read_position];
 		}
 
 		this->position = this->read_position;
@@ -158,40 +196,54 @@ namespace interp::lexer
 		}
 		else
 		{
-			return this->input.at(this->read_position);
+			return this->input[this->read_position];
 		}
 	}
 
-	void Lexer::skip_whitespace()
+	// Moves to position and loads the character there
+	void Lexer::seek(size_t position)
 	{
-		while (this->ch == ' ' || this->ch == '\n' || this->ch == '\t' || this->ch == '\r')
-		{
-			this->read_char();
-		}
+		this->read_position = position;
+		this->read_char();
 	}
 
-	std::string Lexer::read_while(bool (*func)(char))
+	void Lexer::skip_whitespace()
 	{
-		auto initial_position = this->position;
-		while (func(this->ch))
+		if (scan::is_whitespace(this->ch))
 		{
-			this->read_char();
+			this->scan_while<&scan::is_whitespace>(&scan::skip_whitespace);
 		}
-		return this->input.substr(initial_position, this->position - initial_position);
 	}
 
-	std::string Lexer::read_until(bool (*func)(char))
+	// Consumes the run of characters in the class of func, starting at the
+	// current character. Most runs are short, so the first block is checked
+	// in place and only longer runs are handed to the vectorized scanner.
+	template <bool (*func)(char)>
+	interp::token::Span Lexer::scan_while(const char* (*scanner)(const char*, const char*))
 	{
 		auto initial_position = this->position;
-		while (!func(this->ch) && this->ch != 0)
+		auto end = this->input.size();
+		if (initial_position < end)
 		{
-			this->read_char();
+			auto stop = initial_position;
+			auto short_end = std::min(end, initial_position + SHORT_RUN);
+			while (stop < short_end && func(this->input[stop]))
+			{
+				stop++;
+			}
+			if (stop == short_end && stop < end)
+			{
+				auto begin = this->input.data();
+				stop = scanner(begin + stop, begin + end) - begin;
+			}
+			this->seek(stop);
 		}
-		return this->input.substr(initial_position, this->position - initial_position);
+		return {static_cast<uint32_t>(initial_position), static_cast<uint32_t>(this->position - initial_position)};
 	}
 
-	interp::token::Token Lexer::new_token(interp::token::TokenType Type, char in_ch)
+	// Token spanning from start up to and including the current character
+	interp::token::SpanToken Lexer::new_token(interp::token::TokenType Type, size_t start)
 	{
-		return {.type = Type, .literal = std::string(1, in_ch)};
+		return {.type = Type, .span = {static_cast<uint32_t>(start), static_cast<uint32_t>(this->position - start + 1)}};
 	}
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
+#include <string_view>
 #include "token.h"
 
 namespace interp::lexer
@@ -8,21 +10,36 @@ namespace interp::lexer
 	class Lexer
 	{
 	public:
+		// Lexes a private copy of input.
 		Lexer(std::string input);
 		~Lexer() = default;
+
+		// Lexes input in place without copying it. The caller must keep the
+		// underlying buffer alive for as long as the lexer or any span it
+		// returned is used.
+		static Lexer borrow(std::string_view input);
+
 		interp::token::Token next_token();
+		interp::token::SpanToken next_span_token();
+
+		std::string_view text(interp::token::Span span) const;
+		interp::token::Token materialize(const interp::token::SpanToken& token) const;
 
 	private:
-		std::string input;
+		Lexer(std::shared_ptr<const std::string> owned, std::string_view input);
+
+		std::shared_ptr<const std::string> owned;
+		std::string_view input;
 		size_t position;
 		size_t read_position;
 		char ch;
 
 		void read_char();
 		char peek_char();
+		void seek(size_t position);
 		void skip_whitespace();
-		std::string read_while(bool (*func)(char));
-		std::string read_until(bool(*func)(char));
-		interp::token::Token new_token(interp::token::TokenType Type, char in_ch);
+		template <bool (*func)(char)>
+		interp::token::Span scan_while(const char* (*scanner)(const char*, const char*));
+		interp::token::SpanToken new_token(interp::token::TokenType Type, size_t start);
 	};
 }
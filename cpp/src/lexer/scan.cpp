@@ -0,0 +1,267 @@
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+
+#include "scan.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define INTERP_SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define INTERP_TARGET_AVX2
+#else
+#define INTERP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace interp::lexer::scan
+{
+	template <bool (*Class)(char)>
+	const char* skip_scalar(const char* begin, const char* end)
+	{
+		while (begin < end && Class(*begin))
+		{
+			begin++;
+		}
+		return begin;
+	}
+
+#ifdef INTERP_SCAN_X86
+	// The block classifiers return a vector with 0xFF in every lane whose
+	// character belongs to the class.
+
+	__m128i whitespace_sse2(__m128i block)
+	{
+		return _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'))),
+			_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\r'))));
+	}
+
+	// x is in [lo, lo + span] iff (x - lo) as an unsigned byte is <= span
+	__m128i in_range_sse2(__m128i block, char lo, char span)
+	{
+		auto offset = _mm_sub_epi8(block, _mm_set1_epi8(lo));
+		return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(span)), offset);
+	}
+
+	__m128i letters_sse2(__m128i block)
+	{
+		auto lower = _mm_or_si128(block, _mm_set1_epi8(0x20));
+		return _mm_or_si128(in_range_sse2(lower, 'a', 'z' - 'a'), _mm_cmpeq_epi8(block, _mm_set1_epi8('_')));
+	}
+
+	__m128i digits_sse2(__m128i block)
+	{
+		return in_range_sse2(block, '0', '9' - '0');
+	}
+
+	__m128i string_body_sse2(__m128i block)
+	{
+		auto stop = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')), _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+		return _mm_xor_si128(stop, _mm_set1_epi8(-1));
+	}
+
+	template <__m128i (*Classify)(__m128i), bool (*Class)(char)>
+	const char* skip_sse2(const char* begin, const char* end)
+	{
+		while (end - begin >= 16)
+		{
+			auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+			uint32_t outside = ~static_cast<uint32_t>(_mm_movemask_epi8(Classify(block))) & 0xFFFF;
+			if (outside)
+			{
+				return begin + std::countr_zero(outside);
+			}
+			begin += 16;
+		}
+		return skip_scalar<Class>(begin, end);
+	}
+
+	INTERP_TARGET_AVX2 __m256i whitespace_avx2(__m256i block)
+	{
+		return _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'))),
+			_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r'))));
+	}
+
+	INTERP_TARGET_AVX2 __m256i in_range_avx2(__m256i block, char lo, char span)
+	{
+		auto offset = _mm256_sub_epi8(block, _mm256_set1_epi8(lo));
+		return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(span)), offset);
+	}
+
+	INTERP_TARGET_AVX2 __m256i letters_avx2(__m256i block)
+	{
+		auto lower = _mm256_or_si256(block, _mm256_set1_epi8(0x20));
+		return _mm256_or_si256(in_range_avx2(lower, 'a', 'z' - 'a'), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('_')));
+	}
+
+	INTERP_TARGET_AVX2 __m256i digits_avx2(__m256i block)
+	{
+		return in_range_avx2(block, '0', '9' - '0');
+	}
+
+	INTERP_TARGET_AVX2 __m256i string_body_avx2(__m256i block)
+	{
+		auto stop = _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+		return _mm256_xor_si256(stop, _mm256_set1_epi8(-1));
+	}
+
+	template <__m256i (*Classify)(__m256i), __m128i (*ClassifySSE2)(__m128i), bool (*Class)(char)>
+	INTERP_TARGET_AVX2 const char* skip_avx2(const char* begin, const char* end)
+	{
+		while (end - begin >= 32)
+		{
+			auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+			uint32_t outside = ~static_cast<uint32_t>(_mm256_movemask_epi8(Classify(block)));
+			if (outside)
+			{
+				return begin + std::countr_zero(outside);
+			}
+			begin += 32;
+		}
+		return skip_sse2<ClassifySSE2, Class>(begin, end);
+	}
+
+	bool cpu_has_avx2()
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	struct Scanners
+	{
+		Isa isa;
+		const char* (*whitespace)(const char*, const char*);
+		const char* (*letters)(const char*, const char*);
+		const char* (*digits)(const char*, const char*);
+		const char* (*string_body)(const char*, const char*);
+	};
+
+	const Scanners scalar_scanners = {
+		Isa::Scalar,
+		skip_scalar<is_whitespace>,
+		skip_scalar<is_letter>,
+		skip_scalar<is_digit>,
+		skip_scalar<is_string_body>,
+	};
+
+#ifdef INTERP_SCAN_X86
+	const Scanners sse2_scanners = {
+		Isa::SSE2,
+		skip_sse2<whitespace_sse2, is_whitespace>,
+		skip_sse2<letters_sse2, is_letter>,
+		skip_sse2<digits_sse2, is_digit>,
+		skip_sse2<string_body_sse2, is_string_body>,
+	};
+
+	const Scanners avx2_scanners = {
+		Isa::AVX2,
+		skip_avx2<whitespace_avx2, whitespace_sse2, is_whitespace>,
+		skip_avx2<letters_avx2, letters_sse2, is_letter>,
+		skip_avx2<digits_avx2, digits_sse2, is_digit>,
+		skip_avx2<string_body_avx2, string_body_sse2, is_string_body>,
+	};
+#endif
+
+	const Scanners* scanners_for(Isa isa)
+	{
+		switch (isa)
+		{
+#ifdef INTERP_SCAN_X86
+		case Isa::AVX2:
+			return cpu_has_avx2() ? &avx2_scanners : nullptr;
+		case Isa::SSE2:
+			return &sse2_scanners;
+#endif
+		case Isa::Scalar:
+			return &scalar_scanners;
+		default:
+			return nullptr;
+		}
+	}
+
+	Isa best_isa()
+	{
+		for (auto isa : {Isa::AVX2, Isa::SSE2})
+		{
+			if (scanners_for(isa))
+				return isa;
+		}
+		return Isa::Scalar;
+	}
+
+	const Scanners*& active_scanners()
+	{
+		static const Scanners* active = scanners_for(best_isa());
+		return active;
+	}
+
+	Isa active_isa()
+	{
+		return active_scanners()->isa;
+	}
+
+	bool set_isa(Isa isa)
+	{
+		if (auto scanners = scanners_for(isa))
+		{
+			active_scanners() = scanners;
+			return true;
+		}
+		return false;
+	}
+
+	const char* isa_to_string(Isa isa)
+	{
+		switch (isa)
+		{
+		case Isa::Scalar:
+			return "scalar";
+		case Isa::SSE2:
+			return "sse2";
+		case Isa::AVX2:
+			return "avx2";
+		default:
+			return "unknown";
+		}
+	}
+
+	const char* skip_whitespace(const char* begin, const char* end)
+	{
+		return active_scanners()->whitespace(begin, end);
+	}
+
+	const char* skip_letters(const char* begin, const char* end)
+	{
+		return active_scanners()->letters(begin, end);
+	}
+
+	const char* skip_digits(const char* begin, const char* end)
+	{
+		return active_scanners()->digits(begin, end);
+	}
+
+	const char* skip_string_body(const char* begin, const char* end)
+	{
+		return active_scanners()->string_body(begin, end);
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace interp::lexer::scan
+{
+	// Instruction set used by the scanners, picked once at startup from what
+	// the CPU supports. Scalar is always available.
+	enum struct Isa
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+	};
+
+	Isa active_isa();
+	Isa best_isa();
+	// Forces a specific implementation, for tests and benchmarks. Returns false
+	// and leaves the active one untouched if the CPU does not support isa.
+	bool set_isa(Isa isa);
+	const char* isa_to_string(Isa isa);
+
+	// The character classes the scanners skip, also used by the lexer for
+	// single characters so both always agree.
+	inline bool is_whitespace(char ch)
+	{
+		return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r';
+	}
+
+	inline bool is_letter(char ch)
+	{
+		return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+	}
+
+	inline bool is_digit(char ch)
+	{
+		return ch >= '0' && ch <= '9';
+	}
+
+	inline bool is_string_body(char ch)
+	{
+		return ch != '"' && ch != 0;
+	}
+
+	// Each scanner returns a pointer to the first character in [begin, end)
+	// that is not part of the run it skips, or end.
+	const char* skip_whitespace(const char* begin, const char* end);
+	const char* skip_letters(const char* begin, const char* end);
+	const char* skip_digits(const char* begin, const char* end);
+	// Stops at the closing '"' or at a '\0', which the lexer treats as EOF.
+	const char* skip_string_body(const char* begin, const char* end);
+}
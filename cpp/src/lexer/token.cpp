@@ -1,22 +1,167 @@
+#include <array>
+
 #include "token.h"
 
 namespace interp::token {
-	std::map<std::string, TokenType> keywords({
-		std::pair("fn", FUNCTION),
-		std::pair("let", LET),
-		std::pair("true", TRUE),
-		std::pair("false", FALSE),
-		std::pair("if", IF),
-		std::pair("else", ELSE),
-		std::pair("return", RETURN),
-	});
-
-	TokenType lookup_ident(std::string literal)
+	struct Keyword
+	{
+		std::string_view literal;
+		TokenType type;
+	};
+
+	constexpr Keyword keywords[] = {
+		{"fn", FUNCTION},
+		{"let", LET},
+		{"true", TRUE},
+		{"false", FALSE},
+		{"if", IF},
+		{"else", ELSE},
+		{"return", RETURN},
+		{"while", WHILE},
+		{"for", FOR},
+		{"in", IN},
+	};
+
+	constexpr size_t KEYWORD_TABLE_SIZE = 16;
+
+	// Perfect hash over the keyword set, checked at compile time below.
+	// Only the first and last characters and the length are inspected so
+	// that a lookup costs a handful of instructions and one string compare.
+	constexpr size_t keyword_hash(std::string_view literal)
+	{
+		return (static_cast<size_t>(literal.front()) * 2
+			+ static_cast<size_t>(literal.back()) * 3
+			+ literal.size()) & (KEYWORD_TABLE_SIZE - 1);
+	}
+
+	constexpr std::array<Keyword, KEYWORD_TABLE_SIZE> build_keyword_table()
+	{
+		std::array<Keyword, KEYWORD_TABLE_SIZE> table{};
+		for (auto& keyword : table)
+		{
+			keyword = {"", IDENT};
+		}
+		for (auto& keyword : keywords)
+		{
+			table[keyword_hash(keyword.literal)] = keyword;
+		}
+		return table;
+	}
+
+	constexpr bool keyword_hash_is_perfect()
 	{
-		if (keywords.find(literal) == keywords.end()) {
+		auto table = build_keyword_table();
+		for (auto& keyword : keywords)
+		{
+			if (table[keyword_hash(keyword.literal)].literal != keyword.literal)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static_assert(keyword_hash_is_perfect(), "keyword_hash has collisions, adjust it or KEYWORD_TABLE_SIZE");
+
+	constexpr auto keyword_table = build_keyword_table();
+
+	constexpr size_t MIN_KEYWORD_LENGTH = 2;
+	constexpr size_t MAX_KEYWORD_LENGTH = 6;
+
+	TokenType lookup_ident(std::string_view literal)
+	{
+		if (literal.size() < MIN_KEYWORD_LENGTH || literal.size() > MAX_KEYWORD_LENGTH)
+		{
 			return IDENT;
-		} else {
-			return keywords[literal];
 		}
+
+		auto& keyword = keyword_table[keyword_hash(literal)];
+		return keyword.literal == literal ? keyword.type : IDENT;
 	};
-}
\ No newline at end of file
+
+	std::string token_type_to_string(TokenType type)
+	{
+		switch (type)
+		{
+		case ILLEGAL:
+			return "ILLEGAL";
+		case L_EOF:
+			return "EOF";
+		case IDENT:
+			return "IDENT";
+		case INT:
+			return "INT";
+		case ASSIGN:
+			return "=";
+		case EQUAL:
+			return "==";
+		case PLUS:
+			return "+";
+		case MINUS:
+			return "-";
+		case ASTERISK:
+			return "*";
+		case FORWARDSLASH:
+			return "/";
+		case BANG:
+			return "!";
+		case NOTEQUAL:
+			return "!=";
+		case LESSTHAN:
+			return "<";
+		case LESSTHANOREQUAL:
+			return "<=";
+		case GREATERTHAN:
+			return ">";
+		case GREATERTHANOREQUAL:
+			return ">=";
+		case COMMA:
+			return ",";
+		case SEMICOLON:
+			return ";";
+		case COLON:
+			return ":";
+		case LPAREN:
+			return "(";
+		case RPAREN:
+			return ")";
+		case LBRACE:
+			return "{";
+		case RBRACE:
+			return "}";
+		case LBRACKET:
+			return "[";
+		case RBRACKET:
+			return "]";
+		case FUNCTION:
+			return "FUNCTION";
+		case LET:
+			return "LET";
+		case TRUE:
+			return "TRUE";
+		case FALSE:
+			return "FALSE";
+		case IF:
+			return "IF";
+		case ELSE:
+			return "ELSE";
+		case RETURN:
+			return "RETURN";
+		case WHILE:
+			return "WHILE";
+		case FOR:
+			return "FOR";
+		case IN:
+			return "IN";
+		case STRING:
+			return "STRING";
+		default:
+			return "Unknown Type";
+		}
+	}
+
+	std::ostream& operator<<(std::ostream& os, TokenType type)
+	{
+		return os << token_type_to_string(type);
+	}
+}
@@ -1,11 +1,64 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
-#include <map>
+#include <string>
+#include <string_view>
 
 namespace interp::token
 {
-	typedef std::string TokenType;
+	enum struct TokenType : uint8_t
+	{
+		ILLEGAL,
+		L_EOF,
+
+		// Identifiers + literals
+		IDENT,
+		INT,
+
+		// Operators
+		ASSIGN,
+		EQUAL,
+		PLUS,
+		MINUS,
+		ASTERISK,
+		FORWARDSLASH,
+		BANG,
+		NOTEQUAL,
+		LESSTHAN,
+		LESSTHANOREQUAL,
+		GREATERTHAN,
+		GREATERTHANOREQUAL,
+
+		// Delimiters
+		COMMA,
+		SEMICOLON,
+		COLON,
+
+		LPAREN,
+		RPAREN,
+		LBRACE,
+		RBRACE,
+		LBRACKET,
+		RBRACKET,
+
+		// Keywords
+		FUNCTION,
+		LET,
+		TRUE,
+		FALSE,
+		IF,
+		ELSE,
+		RETURN,
+		WHILE,
+		FOR,
+		IN,
+		STRING,
+
+		COUNT, // Number of token types, keep last
+	};
+
+	constexpr size_t TOKEN_TYPE_COUNT = static_cast<size_t>(TokenType::COUNT);
 
 	struct Token
 	{
@@ -13,46 +66,70 @@ namespace interp::token
 		std::string literal;
 	};
 
-	const TokenType
-		ILLEGAL = "ILLEGAL",
-		L_EOF = "EOF",
+	// Location of a token's text in the lexer's input.
+	struct Span
+	{
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	// Token as produced by the lexer, referring back into the input instead of
+	// owning a copy of its literal. See Lexer::materialize.
+	struct SpanToken
+	{
+		TokenType type;
+		Span span;
+	};
+
+	constexpr TokenType
+		ILLEGAL = TokenType::ILLEGAL,
+		L_EOF = TokenType::L_EOF,
 
 		// Identifiers + literals
-		IDENT = "IDENT", // add, foobar, x, y, ...
-		INT = "INT",	 // 1343456
+		IDENT = TokenType::IDENT, // add, foobar, x, y, ...
+		INT = TokenType::INT,	  // 1343456
 
 		// Operators
-		ASSIGN = "=",
-		EQUAL = "==",
-		PLUS = "+",
-		MINUS = "-",
-		ASTERISK = "*",
-		FORWARDSLASH = "/",
-		BANG = "!",
-		NOTEQUAL = "!=",
-		LESSTHAN = "<",
-		LESSTHANOREQUAL = "<=",
-		GREATERTHAN = ">",
-		GREATERTHANOREQUAL = ">=",
+		ASSIGN = TokenType::ASSIGN,
+		EQUAL = TokenType::EQUAL,
+		PLUS = TokenType::PLUS,
+		MINUS = TokenType::MINUS,
+		ASTERISK = TokenType::ASTERISK,
+		FORWARDSLASH = TokenType::FORWARDSLASH,
+		BANG = TokenType::BANG,
+		NOTEQUAL = TokenType::NOTEQUAL,
+		LESSTHAN = TokenType::LESSTHAN,
+		LESSTHANOREQUAL = TokenType::LESSTHANOREQUAL,
+		GREATERTHAN = TokenType::GREATERTHAN,
+		GREATERTHANOREQUAL = TokenType::GREATERTHANOREQUAL,
 
 		// Delimiters
-		COMMA = ",",
-		SEMICOLON = ";",
+		COMMA = TokenType::COMMA,
+		SEMICOLON = TokenType::SEMICOLON,
+		COLON = TokenType::COLON,
 
-		LPAREN = "(",
-		RPAREN = ")",
-		LBRACE = "{",
-		RBRACE = "}",
+		LPAREN = TokenType::LPAREN,
+		RPAREN = TokenType::RPAREN,
+		LBRACE = TokenType::LBRACE,
+		RBRACE = TokenType::RBRACE,
+		LBRACKET = TokenType::LBRACKET,
+		RBRACKET = TokenType::RBRACKET,
 
 		// Keywords
-		FUNCTION = "FUNCTION",
-		LET = "LET",
-		TRUE = "TRUE",
-		FALSE = "FALSE",
-		IF = "IF",
-		ELSE = "ELSE",
-		RETURN = "RETURN",
-		STRING = "STRING";
-
-	TokenType lookup_ident(std::string literal);
+		FUNCTION = TokenType::FUNCTION,
+		LET = TokenType::LET,
+		TRUE = TokenType::TRUE,
+		FALSE = TokenType::FALSE,
+		IF = TokenType::IF,
+		ELSE = TokenType::ELSE,
+		RETURN = TokenType::RETURN,
+		WHILE = TokenType::WHILE,
+		FOR = TokenType::FOR,
+		IN = TokenType::IN,
+		STRING = TokenType::STRING;
+
+	std::string token_type_to_string(TokenType type);
+	std::ostream& operator<<(std::ostream& os, TokenType type);
+
+	TokenType lookup_ident(std::string_view literal);
 }
@@ -1,8 +1,37 @@
 #include <iostream>
+#include <string>
 
 #include "repl/repl.h"
+#include "parser/object/pool.h"
 
-int main()
+int main(int argc, char** argv)
 {
-	interp::repl::start();
-}
\ No newline at end of file
+	auto engine = interp::repl::Engine::Tree;
+	const char* script = nullptr;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg.rfind("--engine=", 0) == 0 && interp::repl::engine_from_string(arg.substr(9), engine))
+			continue;
+
+		if (arg.rfind("--", 0) == 0 || script)
+		{
+			std::cerr << "usage: " << argv[0] << " [--engine=tree|vm|stack] [script]\n";
+			return interp::repl::EXIT_IO_ERROR;
+		}
+
+		script = argv[i];
+	}
+
+	if (script)
+	{
+		auto status = interp::repl::run_file(script, engine);
+#ifdef DEBUG
+		interp::object::pool::report(std::cerr);
+#endif
+		return status;
+	}
+
+	interp::repl::start(engine);
+}
@@ -1,17 +1,25 @@
 #pragma once
 
+#include "./ast/arena.h"
+#include "./ast/array.h"
+#include "./ast/assign.h"
 #include "./ast/ast_string.h"
 #include "./ast/block.h"
 #include "./ast/bool.h"
 #include "./ast/call.h"
 #include "./ast/expr.h"
 #include "./ast/fn_literal.h"
+#include "./ast/for.h"
+#include "./ast/hash.h"
 #include "./ast/ident.h"
 #include "./ast/if.h"
+#include "./ast/index.h"
 #include "./ast/infix.h"
 #include "./ast/int.h"
 #include "./ast/let.h"
 #include "./ast/node.h"
+#include "./ast/operator.h"
 #include "./ast/prefix.h"
 #include "./ast/program.h"
-#include "./ast/return.h"
\ No newline at end of file
+#include "./ast/return.h"
+#include "./ast/while.h"
\ No newline at end of file
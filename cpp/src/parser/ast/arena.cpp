@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "arena.h"
+
+namespace interp::ast
+{
+	AstArena::~AstArena()
+	{
+		for (auto it = this->nodes.rbegin(); it != this->nodes.rend(); it++)
+		{
+			(*it)->~Node();
+		}
+	}
+
+	size_t AstArena::node_count() const
+	{
+		return this->nodes.size();
+	}
+
+	size_t AstArena::bytes_allocated() const
+	{
+		return this->allocated;
+	}
+
+	void* AstArena::allocate(size_t size, size_t alignment)
+	{
+		auto address = reinterpret_cast<uintptr_t>(this->cursor);
+		auto aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+		if (!this->cursor || aligned + size > reinterpret_cast<uintptr_t>(this->limit))
+		{
+			// Oversized nodes get a chunk of their own, chunks are allocated
+			// with new[] so they are aligned for any node type
+			auto chunk_size = std::max(CHUNK_SIZE, size + alignment);
+			this->chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(chunk_size));
+			this->cursor = this->chunks.back().get();
+			this->limit = this->cursor + chunk_size;
+
+			address = reinterpret_cast<uintptr_t>(this->cursor);
+			aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+		}
+
+		this->cursor = reinterpret_cast<std::byte*>(aligned + size);
+		this->allocated += size;
+		return reinterpret_cast<void*>(aligned);
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "node.h"
+
+namespace interp::ast
+{
+	// Owns every node of a parsed program. Nodes are bump allocated out of
+	// large chunks so that a tree sits in a few contiguous blocks of memory,
+	// refer to each other with plain pointers and are all released together
+	// when the arena goes away.
+	class AstArena : public std::enable_shared_from_this<AstArena>
+	{
+	public:
+		AstArena() = default;
+		~AstArena();
+
+		AstArena(const AstArena&) = delete;
+		AstArena& operator=(const AstArena&) = delete;
+
+		template <typename T, typename... Args>
+		T* make(Args&&... args)
+		{
+			static_assert(std::is_base_of_v<Node, T>, "AstArena only holds AST nodes");
+
+			auto node = new (this->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+			this->nodes.push_back(node);
+			return node;
+		}
+
+		size_t node_count() const;
+		size_t bytes_allocated() const;
+
+	private:
+		static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+		void* allocate(size_t size, size_t alignment);
+
+		std::vector<std::unique_ptr<std::byte[]>> chunks;
+		std::byte* cursor = nullptr;
+		std::byte* limit = nullptr;
+		size_t allocated = 0;
+		// Every node in allocation order, so destructors can run on teardown
+		std::vector<Node*> nodes;
+	};
+}
@@ -0,0 +1,37 @@
+#include "array.h"
+
+namespace interp::ast
+{
+	ArrayLiteral::ArrayLiteral(interp::token::Token token)
+		: token(token), elements({})
+	{
+	}
+
+	std::string ArrayLiteral::token_literal()
+	{
+		return this->token.literal;
+	}
+
+	std::string ArrayLiteral::string()
+	{
+		std::string out = "[";
+
+		for (size_t i = 0; i < this->elements.size(); i++)
+		{
+			out += this->elements[i]->string();
+			if (i < this->elements.size() - 1)
+			{
+				out += ", ";
+			}
+		}
+
+		out += "]";
+
+		return out;
+	}
+
+	NodeType ArrayLiteral::type() const
+	{
+		return NodeType::ArrayLiteral;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+
+#include "node.h"
+#include "lexer/token.h"
+
+namespace interp::ast
+{
+	class ArrayLiteral : public Expression
+	{
+	public:
+		ArrayLiteral(interp::token::Token token);
+		~ArrayLiteral() = default;
+
+		interp::token::Token token;
+		std::vector<Expression*> elements;
+
+		std::string token_literal() override;
+		std::string string() override;
+		NodeType type() const override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "assign.h"
+
+namespace interp::ast
+{
+	AssignExpression::AssignExpression(interp::token::Token token, Identifier* name, Expression* value)
+		: token(token), name(name), value(value)
+	{
+	}
+
+	std::string AssignExpression::token_literal()
+	{
+		return this->token.literal;
+	}
+
+	std::string AssignExpression::string()
+	{
+		return "(" + this->name->string() + " = " + this->value->string() + ")";
+	}
+
+	NodeType AssignExpression::type() const
+	{
+		return NodeType::AssignExpression;
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ident.h"
+#include "node.h"
+#include "lexer/token.h"
+
+namespace interp::ast
+{
+	// name = value, storing into a variable that is already declared
+	class AssignExpression : public Expression
+	{
+	public:
+		AssignExpression(interp::token::Token token, Identifier* name, Expression* value);
+		~AssignExpression() = default;
+
+		interp::token::Token token;
+		Identifier* name;
+		Expression* value;
+
+		std::string token_literal() override;
+		std::string string() override;
+		NodeType type() const override;
+	};
+}
\ No newline at end of file
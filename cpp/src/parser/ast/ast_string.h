@@ -2,6 +2,7 @@
 
 #include "node.h"
 #include "lexer/token.h"
+#include "object/value.h"
 
 namespace interp::ast
 {
@@ -13,6 +14,9 @@ namespace interp::ast
 
 		interp::token::Token token;
 		std::string value;
+		// The string object every evaluation of the literal shares, made
+		// ahead of time by the folder. Empty until then.
+		interp::object::Value cached;
 
 		std::string token_literal() override;
 		std::string string() override;
@@ -14,7 +14,12 @@ namespace interp::ast
 		~BlockExpression() = default;
 
 		interp::token::Token token;
-		std::vector<std::shared_ptr<Statement>> statements;
+		std::vector<Statement*> statements;
+		// Set by the resolver: whether the block gets an environment of its
+		// own, and how many slots it has. Without one the block's variables
+		// live in the environment of the function or loop around it.
+		bool own_env = true;
+		uint32_t locals = 0;
 
 		std::string token_literal() override;
 		std::string string() override;
@@ -7,7 +7,7 @@ namespace interp::ast
 	{
 	}
 
-	CallExpression::CallExpression(interp::token::Token token, std::shared_ptr<Expression> function)
+	CallExpression::CallExpression(interp::token::Token token, Expression* function)
 		: token(token), function(function), args({})
 	{
 	}
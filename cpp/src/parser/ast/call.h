@@ -11,12 +11,15 @@ namespace interp::ast
 	{
 	public:
 		CallExpression(interp::token::Token token);
-		CallExpression(interp::token::Token token, std::shared_ptr<Expression> function);
+		CallExpression(interp::token::Token token, Expression* function);
 		~CallExpression() = default;
 
 		interp::token::Token token;
-		std::shared_ptr<Expression> function;
-		std::vector<std::shared_ptr<Expression>> args;
+		Expression* function;
+		std::vector<Expression*> args;
+		// Set by the resolver when the call's result is the result of the
+		// function it is in, so the call can replace that function's frame
+		bool tail = false;
 
 		std::string token_literal() override;
 		std::string string() override;
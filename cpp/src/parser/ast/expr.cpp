@@ -2,7 +2,7 @@
 
 namespace interp::ast
 {
-	ExpressionStatement::ExpressionStatement(interp::token::Token token, std::shared_ptr<Expression> expression)
+	ExpressionStatement::ExpressionStatement(interp::token::Token token, Expression* expression)
 		: token(token), expression(expression)
 	{
 	}
@@ -8,11 +8,11 @@ namespace interp::ast
 	class ExpressionStatement : public Statement
 	{
 	public:
-		ExpressionStatement(interp::token::Token token, std::shared_ptr<Expression> expression);
+		ExpressionStatement(interp::token::Token token, Expression* expression);
 		~ExpressionStatement() = default;
 
 		interp::token::Token token;
-		std::shared_ptr<Expression> expression;
+		Expression* expression;
 
 		std::string token_literal() override;
 		std::string string() override;
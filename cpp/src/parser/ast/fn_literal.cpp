@@ -2,8 +2,8 @@
 
 namespace interp::ast
 {
-	FunctionLiteral::FunctionLiteral(interp::token::Token token)
-		: token(token), params({}), body(nullptr)
+	FunctionLiteral::FunctionLiteral(interp::token::Token token, AstArena* arena)
+		: token(token), arena(arena), params({}), body(nullptr)
 	{
 	}
 
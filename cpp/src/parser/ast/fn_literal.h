@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "arena.h"
 #include "ident.h"
 #include "node.h"
 #include "lexer/token.h"
@@ -11,12 +12,17 @@ namespace interp::ast
 	class FunctionLiteral : public Expression
 	{
 	public:
-		FunctionLiteral(interp::token::Token token);
+		FunctionLiteral(interp::token::Token token, AstArena* arena);
 		~FunctionLiteral() = default;
 
 		interp::token::Token token;
-		std::vector<std::shared_ptr<Identifier>> params;
-		std::shared_ptr<Expression> body;
+		// Arena the literal lives in, functions created from it keep it alive
+		AstArena* arena;
+		std::vector<Identifier*> params;
+		Expression* body;
+		// Slots of a call's environment, for the parameters and the variables
+		// of the blocks in the body, set by the resolver
+		uint32_t locals = 0;
 
 		std::string token_literal() override;
 		std::string string() override;
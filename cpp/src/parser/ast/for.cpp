@@ -0,0 +1,24 @@
+#include "for.h"
+
+namespace interp::ast
+{
+	ForExpression::ForExpression(interp::token::Token token, Identifier variable, Expression* iterable, BlockExpression* body)
+		: token(token), variable(variable), iterable(iterable), body(body)
+	{
+	}
+
+	std::string ForExpression::token_literal()
+	{
+		return this->token.literal;
+	}
+
+	std::string ForExpression::string()
+	{
+		return "for " + this->variable.string() + " in " + this->iterable->string() + " " + this->body->string();
+	}
+
+	NodeType ForExpression::type() const
+	{
+		return NodeType::ForExpression;
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "block.h"
+#include "ident.h"
+#include "node.h"
+#include "lexer/token.h"
+
+namespace interp::ast
+{
+	// Evaluates body once per element of iterable, an array, with variable
+	// set to the element. Null itself. variable and the body's statements
+	// share the loop's scope, like a WhileExpression's.
+	class ForExpression : public Expression
+	{
+	public:
+		ForExpression(interp::token::Token token, Identifier variable, Expression* iterable, BlockExpression* body);
+		~ForExpression() = default;
+
+		interp::token::Token token;
+		Identifier variable;
+		Expression* iterable;
+		BlockExpression* body;
+		// Set by the resolver, see WhileExpression
+		uint32_t locals = 0;
+		bool captures = false;
+
+		std::string token_literal() override;
+		std::string string() override;
+		NodeType type() const override;
+	};
+}
\ No newline at end of file
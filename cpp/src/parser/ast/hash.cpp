@@ -0,0 +1,42 @@
+#include "hash.h"
+
+namespace interp::ast
+{
+	HashLiteral::HashLiteral(interp::token::Token token)
+		: token(token), pairs({})
+	{
+	}
+
+	std::string HashLiteral::token_literal()
+	{
+		return this->token.literal;
+	}
+
+	std::string HashLiteral::string()
+	{
+		if (this->pairs.empty())
+		{
+			return "{:}";
+		}
+
+		std::string out = "{";
+
+		for (size_t i = 0; i < this->pairs.size(); i++)
+		{
+			out += this->pairs[i].first->string() + ": " + this->pairs[i].second->string();
+			if (i < this->pairs.size() - 1)
+			{
+				out += ", ";
+			}
+		}
+
+		out += "}";
+
+		return out;
+	}
+
+	NodeType HashLiteral::type() const
+	{
+		return NodeType::HashLiteral;
+	}
+}
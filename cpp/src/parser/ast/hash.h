@@ -0,0 +1,25 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "node.h"
+#include "lexer/token.h"
+
+namespace interp::ast
+{
+	class HashLiteral : public Expression
+	{
+	public:
+		HashLiteral(interp::token::Token token);
+		~HashLiteral() = default;
+
+		interp::token::Token token;
+		// Keys and values in source order
+		std::vector<std::pair<Expression*, Expression*>> pairs;
+
+		std::string token_literal() override;
+		std::string string() override;
+		NodeType type() const override;
+	};
+}
\ No newline at end of file
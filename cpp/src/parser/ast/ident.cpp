@@ -2,7 +2,7 @@
 
 namespace interp::ast
 {
-	Identifier::Identifier(interp::token::Token token, std::string value) : token(token), value(value)
+	Identifier::Identifier(interp::token::Token token, std::string value) : token(token), value(value), name(interp::lexer::intern(value))
 	{
 	}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "node.h"
+#include "lexer/atom.h"
 #include "lexer/token.h"
 
 namespace interp::ast
@@ -13,6 +14,12 @@ namespace interp::ast
 
 		interp::token::Token token;
 		std::string value;
+		// value interned, what scopes and environments key names by
+		interp::lexer::Atom name;
+		// Lexical address assigned by the resolver: how many environments out
+		// the variable lives and its slot there
+		uint32_t depth = 0;
+		uint32_t slot = 0;
 
 		std::string token_literal() override;
 		std::string string() override;
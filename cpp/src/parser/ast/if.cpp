@@ -2,7 +2,7 @@
 
 namespace interp::ast
 {
-	IfExpression::IfExpression(interp::token::Token token, std::shared_ptr<Expression> condition, std::shared_ptr<Expression> consequence, std::shared_ptr<Expression> alternative)
+	IfExpression::IfExpression(interp::token::Token token, Expression* condition, Expression* consequence, Expression* alternative)
 		: token(token), condition(condition), consequence(consequence), alternative(alternative)
 	{
 	}
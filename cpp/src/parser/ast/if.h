@@ -8,13 +8,13 @@ namespace interp::ast
 	class IfExpression : public Expression
 	{
 	public:
-		IfExpression(interp::token::Token token, std::shared_ptr<Expression> condition, std::shared_ptr<Expression> consequence, std::shared_ptr<Expression> alternative = nullptr);
+		IfExpression(interp::token::Token token, Expression* condition, Expression* consequence, Expression* alternative = nullptr);
 		~IfExpression() = default;
 
 		interp::token::Token token;
-		std::shared_ptr<Expression> condition;
-		std::shared_ptr<Expression> consequence;
-		std::shared_ptr<Expression> alternative;
+		Expression* condition;
+		Expression* consequence;
+		Expression* alternative;
 
 		std::string token_literal() override;
 		std::string string() override;
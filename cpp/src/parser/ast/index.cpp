@@ -0,0 +1,24 @@
+#include "index.h"
+
+namespace interp::ast
+{
+	IndexExpression::IndexExpression(interp::token::Token token, Expression* left, Expression* index)
+		: token(token), left(left), index(index)
+	{
+	}
+
+	std::string IndexExpression::token_literal()
+	{
+		return this->token.literal;
+	}
+
+	std::string IndexExpression::string()
+	{
+		return "(" + this->left->string() + "[" + this->index->string() + "])";
+	}
+
+	NodeType IndexExpression::type() const
+	{
+		return NodeType::IndexExpression;
+	}
+}
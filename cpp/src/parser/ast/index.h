@@ -0,0 +1,22 @@
+#pragma once
+
+#include "node.h"
+#include "lexer/token.h"
+
+namespace interp::ast
+{
+	class IndexExpression : public Expression
+	{
+	public:
+		IndexExpression(interp::token::Token token, Expression* left, Expression* index);
+		~IndexExpression() = default;
+
+		interp::token::Token token;
+		Expression* left;
+		Expression* index;
+
+		std::string token_literal() override;
+		std::string string() override;
+		NodeType type() const override;
+	};
+}
\ No newline at end of file
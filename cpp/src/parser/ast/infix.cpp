@@ -2,8 +2,8 @@
 
 namespace interp::ast
 {
-	InfixExpression::InfixExpression(interp::token::Token token, std::shared_ptr<Expression> left, std::string p_operator, std::shared_ptr<Expression> right)
-		: token(token), left(left), p_operator(p_operator), right(right)
+	InfixExpression::InfixExpression(interp::token::Token token, Expression* left, std::string p_operator, Operator op, Expression* right)
+		: token(token), left(left), p_operator(p_operator), op(op), right(right)
 	{
 	}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "node.h"
+#include "operator.h"
 #include "lexer/token.h"
 
 namespace interp::ast
@@ -8,13 +9,14 @@ namespace interp::ast
 	class InfixExpression : public Expression
 	{
 	public:
-		InfixExpression(interp::token::Token token, std::shared_ptr<Expression> left, std::string p_operator, std::shared_ptr<Expression> right);
+		InfixExpression(interp::token::Token token, Expression* left, std::string p_operator, Operator op, Expression* right);
 		~InfixExpression() = default;
 
 		interp::token::Token token;
-		std::shared_ptr<Expression> left;
+		Expression* left;
 		std::string p_operator;
-		std::shared_ptr<Expression> right;
+		Operator op;
+		Expression* right;
 
 		std::string token_literal() override;
 		std::string string() override;
@@ -2,7 +2,7 @@
 
 namespace interp::ast
 {
-	LetStatement::LetStatement(interp::token::Token token, Identifier name, std::shared_ptr<Expression> value)
+	LetStatement::LetStatement(interp::token::Token token, Identifier name, Expression* value)
 		: token(token), name(name), value(value)
 	{
 	}
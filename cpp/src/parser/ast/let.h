@@ -9,12 +9,12 @@ namespace interp::ast
 	class LetStatement : public Statement
 	{
 	public:
-		LetStatement(interp::token::Token token, Identifier name, std::shared_ptr<Expression> value);
+		LetStatement(interp::token::Token token, Identifier name, Expression* value);
 		~LetStatement() = default;
 
 		interp::token::Token token;
 		Identifier name;
-		std::shared_ptr<Expression> value;
+		Expression* value;
 
 		std::string token_literal() override;
 		std::string string() override;
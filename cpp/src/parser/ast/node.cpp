@@ -8,6 +8,10 @@ namespace interp::ast
 		{
 		case interp::ast::NodeType::Program:
 			return "Program";
+		case interp::ast::NodeType::ArrayLiteral:
+			return "ArrayLiteral";
+		case interp::ast::NodeType::AssignExpression:
+			return "AssignExpression";
 		case interp::ast::NodeType::BlockExpression:
 			return "BlockExpression";
 		case interp::ast::NodeType::BooleanExpression:
@@ -16,12 +20,18 @@ namespace interp::ast
 			return "CallExpression";
 		case interp::ast::NodeType::ExpressionStatment:
 			return "ExpressionStatment";
+		case interp::ast::NodeType::ForExpression:
+			return "ForExpression";
 		case interp::ast::NodeType::FunctionLiteral:
 			return "FunctionLiteral";
+		case interp::ast::NodeType::HashLiteral:
+			return "HashLiteral";
 		case interp::ast::NodeType::Identifier:
 			return "Identifier";
 		case interp::ast::NodeType::IfExpression:
 			return "IfExpression";
+		case interp::ast::NodeType::IndexExpression:
+			return "IndexExpression";
 		case interp::ast::NodeType::InfixExpression:
 			return "InfixExpression";
 		case interp::ast::NodeType::IntegerLiteral:
@@ -34,6 +44,8 @@ namespace interp::ast
 			return "ReturnStatment";
 		case interp::ast::NodeType::StringLiteral:
 			return "String";
+		case interp::ast::NodeType::WhileExpression:
+			return "WhileExpression";
 		default:
 			return "Unknown Type";
 		}
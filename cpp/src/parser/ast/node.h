@@ -7,19 +7,25 @@ namespace interp::ast
 	enum struct NodeType
 	{
 		Program,
+		ArrayLiteral,
+		AssignExpression,
 		BlockExpression,
 		BooleanExpression,
 		CallExpression,
 		ExpressionStatment,
+		ForExpression,
 		FunctionLiteral,
+		HashLiteral,
 		Identifier,
 		IfExpression,
+		IndexExpression,
 		InfixExpression,
 		IntegerLiteral,
 		LetStatment,
 		PrefixExpression,
 		ReturnStatment,
 		StringLiteral,
+		WhileExpression,
 	};
 
 	std::string node_type_to_string(NodeType node_type);
@@ -0,0 +1,66 @@
+#include "operator.h"
+
+namespace interp::ast
+{
+	Operator operator_from_token(interp::token::TokenType type)
+	{
+		switch (type)
+		{
+		case interp::token::PLUS:
+			return Operator::Plus;
+		case interp::token::MINUS:
+			return Operator::Minus;
+		case interp::token::ASTERISK:
+			return Operator::Asterisk;
+		case interp::token::FORWARDSLASH:
+			return Operator::ForwardSlash;
+		case interp::token::BANG:
+			return Operator::Bang;
+		case interp::token::EQUAL:
+			return Operator::Equal;
+		case interp::token::NOTEQUAL:
+			return Operator::NotEqual;
+		case interp::token::LESSTHAN:
+			return Operator::LessThan;
+		case interp::token::LESSTHANOREQUAL:
+			return Operator::LessThanOrEqual;
+		case interp::token::GREATERTHAN:
+			return Operator::GreaterThan;
+		case interp::token::GREATERTHANOREQUAL:
+			return Operator::GreaterThanOrEqual;
+		default:
+			return Operator::Illegal;
+		}
+	}
+
+	std::string operator_to_string(Operator op)
+	{
+		switch (op)
+		{
+		case Operator::Plus:
+			return "+";
+		case Operator::Minus:
+			return "-";
+		case Operator::Asterisk:
+			return "*";
+		case Operator::ForwardSlash:
+			return "/";
+		case Operator::Bang:
+			return "!";
+		case Operator::Equal:
+			return "==";
+		case Operator::NotEqual:
+			return "!=";
+		case Operator::LessThan:
+			return "<";
+		case Operator::LessThanOrEqual:
+			return "<=";
+		case Operator::GreaterThan:
+			return ">";
+		case Operator::GreaterThanOrEqual:
+			return ">=";
+		default:
+			return "ILLEGAL";
+		}
+	}
+}
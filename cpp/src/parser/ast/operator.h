@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "lexer/token.h"
+
+namespace interp::ast
+{
+	// Operator of a prefix or infix expression, resolved from its token once
+	// by the parser so evaluation never has to look at the operator text.
+	enum struct Operator : uint8_t
+	{
+		Plus,
+		Minus,
+		Asterisk,
+		ForwardSlash,
+		Bang,
+		Equal,
+		NotEqual,
+		LessThan,
+		LessThanOrEqual,
+		GreaterThan,
+		GreaterThanOrEqual,
+		Illegal,
+
+		Count, // Number of operators, keep last
+	};
+
+	constexpr size_t OPERATOR_COUNT = static_cast<size_t>(Operator::Count);
+
+	Operator operator_from_token(interp::token::TokenType type);
+	std::string operator_to_string(Operator op);
+}
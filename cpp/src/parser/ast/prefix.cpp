@@ -2,8 +2,8 @@
 
 namespace interp::ast
 {
-	PrefixExpression::PrefixExpression(interp::token::Token token, std::string p_operator, std::shared_ptr<Expression> right)
-		: token(token), p_operator(p_operator), right(right)
+	PrefixExpression::PrefixExpression(interp::token::Token token, std::string p_operator, Operator op, Expression* right)
+		: token(token), p_operator(p_operator), op(op), right(right)
 	{
 	}
 
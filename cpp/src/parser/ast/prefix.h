@@ -1,6 +1,7 @@
 #pragma once
 
 #include "node.h"
+#include "operator.h"
 #include "lexer/token.h"
 
 namespace interp::ast
@@ -8,12 +9,13 @@ namespace interp::ast
 	class PrefixExpression : public Expression
 	{
 	public:
-		PrefixExpression(interp::token::Token token, std::string p_operator, std::shared_ptr<Expression> right);
+		PrefixExpression(interp::token::Token token, std::string p_operator, Operator op, Expression* right);
 		~PrefixExpression() = default;
 
 		interp::token::Token token;
 		std::string p_operator;
-		std::shared_ptr<Expression> right;
+		Operator op;
+		Expression* right;
 
 		std::string token_literal() override;
 		std::string string() override;
@@ -2,7 +2,8 @@
 
 namespace interp::ast
 {
-	Program::Program(std::vector<std::shared_ptr<Statement>> statements) : statements(statements)
+	Program::Program(std::shared_ptr<AstArena> arena, std::vector<Statement*> statements)
+		: arena(arena), statements(statements)
 	{
 	}
 
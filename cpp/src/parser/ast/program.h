@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "arena.h"
 #include "node.h"
 #include "lexer/token.h"
 
@@ -10,11 +11,12 @@ namespace interp::ast
 	class Program : public Node
 	{
 	public:
-		Program(std::vector<std::shared_ptr<Statement>> statements);
-		Program() = default;
+		Program(std::shared_ptr<AstArena> arena, std::vector<Statement*> statements = {});
 		~Program() = default;
 
-		std::vector<std::shared_ptr<Statement>> statements;
+		// Owns statements and every node below them
+		std::shared_ptr<AstArena> arena;
+		std::vector<Statement*> statements;
 
 		std::string token_literal() override;
 		std::string string() override;
@@ -2,7 +2,7 @@
 
 namespace interp::ast
 {
-	ReturnStatement::ReturnStatement(interp::token::Token token, std::shared_ptr<Expression> return_value)
+	ReturnStatement::ReturnStatement(interp::token::Token token, Expression* return_value)
 		: token(token), return_value(return_value)
 	{
 	}
@@ -8,11 +8,11 @@ namespace interp::ast
 	class ReturnStatement : public Statement
 	{
 	public:
-		ReturnStatement(interp::token::Token token, std::shared_ptr<Expression> return_value);
+		ReturnStatement(interp::token::Token token, Expression* return_value);
 		~ReturnStatement() = default;
 
 		interp::token::Token token;
-		std::shared_ptr<Expression> return_value;
+		Expression* return_value;
 
 		std::string token_literal() override;
 		std::string string() override;
@@ -0,0 +1,24 @@
+#include "while.h"
+
+namespace interp::ast
+{
+	WhileExpression::WhileExpression(interp::token::Token token, Expression* condition, BlockExpression* body)
+		: token(token), condition(condition), body(body)
+	{
+	}
+
+	std::string WhileExpression::token_literal()
+	{
+		return this->token.literal;
+	}
+
+	std::string WhileExpression::string()
+	{
+		return "while " + this->condition->string() + " " + this->body->string();
+	}
+
+	NodeType WhileExpression::type() const
+	{
+		return NodeType::WhileExpression;
+	}
+}
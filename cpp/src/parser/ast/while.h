@@ -0,0 +1,31 @@
+#pragma once
+
+#include "block.h"
+#include "node.h"
+#include "lexer/token.h"
+
+namespace interp::ast
+{
+	// Evaluates body while condition is truthy, and is null itself. The
+	// condition and the body's statements run in one scope, the loop's,
+	// whose environment is reused across iterations unless the body can
+	// capture it.
+	class WhileExpression : public Expression
+	{
+	public:
+		WhileExpression(interp::token::Token token, Expression* condition, BlockExpression* body);
+		~WhileExpression() = default;
+
+		interp::token::Token token;
+		Expression* condition;
+		BlockExpression* body;
+		// Set by the resolver: slots of the loop's scope, and whether the body
+		// makes functions, which need an environment per iteration to capture
+		uint32_t locals = 0;
+		bool captures = false;
+
+		std::string token_literal() override;
+		std::string string() override;
+		NodeType type() const override;
+	};
+}
\ No newline at end of file
@@ -1 +1,133 @@
-#include "builtins.h"
\ No newline at end of file
+#include <unordered_map>
+#include <vector>
+
+#include "builtins.h"
+#include "eval.h"
+
+namespace interp::eval
+{
+	interp::object::Value builtin_len(std::span<const interp::object::Value> args)
+	{
+		if (args.size() != 1)
+			return new_error("wrong number of arguments. got=" + std::to_string(args.size()) + " want=1");
+
+		switch (args[0].type())
+		{
+		case interp::object::ObjectType::StringObject:
+			return interp::object::Value::integer(args[0].as<interp::object::StringObject>()->length());
+		case interp::object::ObjectType::ArrayObject:
+			return interp::object::Value::integer(args[0].as<interp::object::ArrayObject>()->length());
+		case interp::object::ObjectType::HashObject:
+			return interp::object::Value::integer(args[0].as<interp::object::HashObject>()->length());
+		default:
+			return new_error("argument to `len` not supported, got=" + interp::object::object_type_to_string(args[0].type()));
+		}
+	}
+
+	// The array a builtin called name takes as its first argument, or the
+	// error to return for args
+	interp::object::Value array_argument(const char* name, std::span<const interp::object::Value> args, size_t count)
+	{
+		if (args.size() != count)
+			return new_error("wrong number of arguments. got=" + std::to_string(args.size()) + " want=" + std::to_string(count));
+		if (args[0].type() != interp::object::ObjectType::ArrayObject)
+			return new_error(std::string("argument to `") + name + "` must be ARRAY, got " + interp::object::object_type_to_string(args[0].type()));
+		return args[0];
+	}
+
+	interp::object::Value builtin_first(std::span<const interp::object::Value> args)
+	{
+		auto array = array_argument("first", args, 1);
+		if (is_error(array))
+			return array;
+
+		auto elements = array.as<interp::object::ArrayObject>()->elements();
+		return elements.empty() ? interp::object::Value::null() : elements.front();
+	}
+
+	interp::object::Value builtin_last(std::span<const interp::object::Value> args)
+	{
+		auto array = array_argument("last", args, 1);
+		if (is_error(array))
+			return array;
+
+		auto elements = array.as<interp::object::ArrayObject>()->elements();
+		return elements.empty() ? interp::object::Value::null() : elements.back();
+	}
+
+	// Every element but the first, sharing the array's storage
+	interp::object::Value builtin_rest(std::span<const interp::object::Value> args)
+	{
+		auto array = array_argument("rest", args, 1);
+		if (is_error(array))
+			return array;
+
+		auto length = array.as<interp::object::ArrayObject>()->length();
+		if (length == 0)
+			return interp::object::Value::null();
+		return interp::object::ArrayObject::slice(
+			interp::object::Ref<interp::object::ArrayObject>(array.as<interp::object::ArrayObject>()), 1, length - 1);
+	}
+
+	interp::object::Value builtin_push(std::span<const interp::object::Value> args)
+	{
+		auto array = array_argument("push", args, 2);
+		if (is_error(array))
+			return array;
+
+		return interp::object::ArrayObject::push(
+			interp::object::Ref<interp::object::ArrayObject>(array.as<interp::object::ArrayObject>()), args[1]);
+	}
+
+	struct Registry
+	{
+		std::vector<interp::object::Value> functions;
+		std::unordered_map<interp::lexer::Atom, uint32_t, interp::lexer::Atom::Hash> indices;
+
+		Registry()
+		{
+			this->add("len", builtin_len);
+			this->add("first", builtin_first);
+			this->add("last", builtin_last);
+			this->add("rest", builtin_rest);
+			this->add("push", builtin_push);
+		}
+
+		uint32_t add(std::string_view name, interp::object::BuiltinFn fn)
+		{
+			auto obj = interp::object::make_ref<interp::object::BuiltinFnObject>(fn);
+
+			auto [found, inserted] = this->indices.try_emplace(interp::lexer::intern(name), static_cast<uint32_t>(this->functions.size()));
+			if (inserted)
+				this->functions.push_back(obj);
+			else
+				this->functions[found->second] = obj;
+			return found->second;
+		}
+
+		static Registry& get()
+		{
+			thread_local Registry registry;
+			return registry;
+		}
+	};
+
+	uint32_t register_builtin(std::string_view name, interp::object::BuiltinFn fn)
+	{
+		return Registry::get().add(name, fn);
+	}
+
+	std::optional<uint32_t> find_builtin(interp::lexer::Atom name)
+	{
+		auto& registry = Registry::get();
+		auto found = registry.indices.find(name);
+		if (found == registry.indices.end())
+			return std::nullopt;
+		return found->second;
+	}
+
+	const interp::object::Value& builtin(uint32_t index)
+	{
+		return Registry::get().functions[index];
+	}
+}
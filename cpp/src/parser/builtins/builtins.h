@@ -1,35 +1,28 @@
 #pragma once
 
-#include <iostream>
-#include <map>
-#include <string>
+#include <cstdint>
+#include <optional>
+#include <string_view>
 
+#include "lexer/atom.h"
 #include "object.h"
 
 namespace interp::eval
 {
-	std::map<std::string, interp::object::BuiltinFnObject> builtins({
+	// Native functions scripts can call by name. A name that no scope of a
+	// program declares resolves to the builtin of that name, which the
+	// resolver stores in a global slot so calling it costs the same variable
+	// access as any other function; declaring the name shadows it.
+	//
+	// The registry is per thread, like the objects it holds, and starts out
+	// with the standard builtins: len, first, last, rest and push.
 
-		// LEN
-		std::pair("len", interp::object::BuiltinFnObject([](std::vector<std::shared_ptr<interp::object::Object>> args) -> std::shared_ptr<interp::object::Object>
-														 {
-			if (args.size() != 1)
-			{
-				return std::shared_ptr<interp::object::ErrorObject>(
-					new interp::object::ErrorObject("wrong number of arguments. got=" + std::to_string(args.size()) + " want=1"));
-			}
+	// Adds fn under name, or replaces the builtin already called that, and
+	// returns its index. Programs resolved before the call keep the function
+	// they resolved to.
+	uint32_t register_builtin(std::string_view name, interp::object::BuiltinFn fn);
 
-			switch (args[0]->type())
-			{
-			case interp::object::ObjectType::StringObject:
-				if (auto str = dynamic_cast<interp::object::StringObject*>(args[0].get()))
-				{
-					return std::shared_ptr<interp::object::Integer>(
-						new interp::object::Integer(str->value.length()));
-				}
-			default:
-				return std::shared_ptr<interp::object::ErrorObject>(
-					new interp::object::ErrorObject("argument to `len` not supported, got=" + interp::object::object_type_to_string( args[0]->type() )));
-			} })),
-	});
-}
\ No newline at end of file
+	std::optional<uint32_t> find_builtin(interp::lexer::Atom name);
+	// The BuiltinFnObject registered at index
+	const interp::object::Value& builtin(uint32_t index);
+}
@@ -0,0 +1,130 @@
+#include "code.h"
+
+namespace interp::compiler
+{
+	size_t operand_count(OpCode op)
+	{
+		switch (op)
+		{
+		case OpCode::GetVar:
+		case OpCode::Assign:
+			return 3;
+		case OpCode::Constant:
+		case OpCode::SmallInt:
+		case OpCode::SetVar:
+		case OpCode::Prefix:
+		case OpCode::Infix:
+		case OpCode::Array:
+		case OpCode::Hash:
+		case OpCode::Jump:
+		case OpCode::JumpIfFalse:
+		case OpCode::ForNext:
+		case OpCode::PushEnv:
+		case OpCode::Closure:
+		case OpCode::Call:
+		case OpCode::TailCall:
+			return 1;
+		default:
+			return 0;
+		}
+	}
+
+	std::string opcode_to_string(OpCode op)
+	{
+		switch (op)
+		{
+		case OpCode::Constant:
+			return "CONSTANT";
+		case OpCode::SmallInt:
+			return "SMALL_INT";
+		case OpCode::True:
+			return "TRUE";
+		case OpCode::False:
+			return "FALSE";
+		case OpCode::Null:
+			return "NULL";
+		case OpCode::Pop:
+			return "POP";
+		case OpCode::GetVar:
+			return "GET_VAR";
+		case OpCode::SetVar:
+			return "SET_VAR";
+		case OpCode::Assign:
+			return "ASSIGN";
+		case OpCode::Prefix:
+			return "PREFIX";
+		case OpCode::Infix:
+			return "INFIX";
+		case OpCode::Array:
+			return "ARRAY";
+		case OpCode::Hash:
+			return "HASH";
+		case OpCode::Index:
+			return "INDEX";
+		case OpCode::Jump:
+			return "JUMP";
+		case OpCode::JumpIfFalse:
+			return "JUMP_IF_FALSE";
+		case OpCode::ForNext:
+			return "FOR_NEXT";
+		case OpCode::PushEnv:
+			return "PUSH_ENV";
+		case OpCode::PopEnv:
+			return "POP_ENV";
+		case OpCode::Closure:
+			return "CLOSURE";
+		case OpCode::Call:
+			return "CALL";
+		case OpCode::TailCall:
+			return "TAIL_CALL";
+		case OpCode::Return:
+			return "RETURN";
+		default:
+			return "UNKNOWN";
+		}
+	}
+
+	size_t Chunk::emit(OpCode op)
+	{
+		this->code.push_back(static_cast<uint8_t>(op));
+		return this->code.size() - 1;
+	}
+
+	void Chunk::emit_operand(uint32_t operand)
+	{
+		auto offset = this->code.size();
+		this->code.resize(offset + sizeof(operand));
+		std::memcpy(&this->code[offset], &operand, sizeof(operand));
+	}
+
+	void Chunk::patch_operand(size_t offset, uint32_t operand)
+	{
+		std::memcpy(&this->code[offset], &operand, sizeof(operand));
+	}
+
+	std::string disassemble(const Chunk& chunk)
+	{
+		std::string out;
+
+		const uint8_t* start = chunk.code.data();
+		const uint8_t* ip = start;
+		const uint8_t* end = start + chunk.code.size();
+		while (ip < end)
+		{
+			auto op = static_cast<OpCode>(*ip);
+			out += std::to_string(ip - start) + " " + opcode_to_string(op);
+			ip++;
+
+			for (size_t i = 0; i < operand_count(op); i++)
+			{
+				auto operand = read_operand(ip);
+				out += " " + (op == OpCode::SmallInt
+					? std::to_string(static_cast<int32_t>(operand))
+					: std::to_string(operand));
+			}
+			out += "\n";
+		}
+
+		return out;
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ast.h"
+#include "lexer/atom.h"
+#include "object/value.h"
+
+namespace interp::compiler
+{
+	// Instructions of the stack machine. Operands follow the opcode as
+	// native-endian uint32_t, their meaning is listed next to each one.
+	enum struct OpCode : uint8_t
+	{
+		Constant,	 // index: push constants[index]
+		SmallInt,	 // value: push the integer value, stored as an int32_t
+		True,
+		False,
+		Null,
+		Pop,
+		GetVar,		 // depth, slot, name: push the variable, name indexes names for the error if it is unset
+		SetVar,		 // slot: store the top of the stack in the current environment, leaving it there
+		Assign,		 // depth, slot, name: store the top of the stack in a variable that is set, leaving it there
+		Prefix,		 // operator
+		Infix,		 // operator
+		Array,		 // count: replace the top count values with an array of them
+		Hash,		 // count: replace the top count keys and values, each key below its value, with a hash of them
+		Index,		 // replace an array or hash and an index with the element
+		Jump,		 // target
+		JumpIfFalse, // target: pop the condition and jump if it is not truthy
+		ForNext,	 // target: below an array and an index, push the element and advance the index, or pop both and jump once past the end
+		PushEnv,	 // size: enter a block environment with size slots
+		PopEnv,
+		Closure,	 // index: push a function made from functions[index] and the current environment
+		Call,		 // argc: call the function below argc arguments, replacing them with its result
+		TailCall,	 // argc: like Call, but the callee's result is returned, so it reuses the current frame
+		Return,		 // return the top of the stack from the current function
+
+		Count, // Number of opcodes, keep last
+	};
+
+	// Integer literals in this range are pushed by SmallInt instead of taking
+	// a slot in the constant pool.
+	constexpr int64_t SMALL_INT_MIN = -128;
+	constexpr int64_t SMALL_INT_MAX = 1024;
+
+	size_t operand_count(OpCode op);
+	std::string opcode_to_string(OpCode op);
+
+	struct FunctionProto;
+
+	struct Chunk
+	{
+		std::vector<uint8_t> code;
+		std::vector<interp::object::Value> constants;
+		std::vector<interp::lexer::Atom> names;
+		std::vector<std::shared_ptr<const FunctionProto>> functions;
+
+		size_t emit(OpCode op);
+		void emit_operand(uint32_t operand);
+		void patch_operand(size_t offset, uint32_t operand);
+	};
+
+	inline uint32_t read_operand(const uint8_t*& ip)
+	{
+		uint32_t operand;
+		std::memcpy(&operand, ip, sizeof(operand));
+		ip += sizeof(operand);
+		return operand;
+	}
+
+	// Compiled body of a function literal, or of a whole program when literal
+	// is nullptr. Functions created from it refer back to the literal for
+	// their parameters and for printing.
+	struct FunctionProto
+	{
+		interp::ast::FunctionLiteral* literal = nullptr;
+		Chunk chunk;
+	};
+
+	// One instruction per line, for debugging the compiler.
+	std::string disassemble(const Chunk& chunk);
+}
@@ -0,0 +1,336 @@
+#include "compiler.h"
+#include "object.h"
+
+namespace interp::compiler
+{
+	std::shared_ptr<const FunctionProto> Compiler::compile(interp::ast::Program* program)
+	{
+		auto proto = std::shared_ptr<FunctionProto>(new FunctionProto());
+		this->chunk = &proto->chunk;
+		this->name_indices.clear();
+
+		// An empty program evaluates to nothing, so it compiles to nothing.
+		if (!program->statements.empty())
+		{
+			this->compile_statements(program->statements);
+			this->chunk->emit(OpCode::Return);
+		}
+
+		return proto;
+	}
+
+	void Compiler::compile_node(interp::ast::Node* node)
+	{
+		switch (node->type())
+		{
+		case interp::ast::NodeType::ArrayLiteral:
+		{
+			auto literal = static_cast<interp::ast::ArrayLiteral*>(node);
+			for (auto element : literal->elements)
+			{
+				this->compile_node(element);
+			}
+			this->chunk->emit(OpCode::Array);
+			this->chunk->emit_operand(static_cast<uint32_t>(literal->elements.size()));
+			break;
+		}
+		case interp::ast::NodeType::AssignExpression:
+		{
+			auto literal = static_cast<interp::ast::AssignExpression*>(node);
+			this->compile_node(literal->value);
+			this->compile_variable(OpCode::Assign, literal->name);
+			break;
+		}
+		case interp::ast::NodeType::BlockExpression:
+		{
+			auto literal = static_cast<interp::ast::BlockExpression*>(node);
+			if (!literal->own_env)
+			{
+				this->compile_statements(literal->statements);
+				break;
+			}
+			this->chunk->emit(OpCode::PushEnv);
+			this->chunk->emit_operand(literal->locals);
+			this->compile_statements(literal->statements);
+			this->chunk->emit(OpCode::PopEnv);
+			break;
+		}
+		case interp::ast::NodeType::BooleanExpression:
+		{
+			auto literal = static_cast<interp::ast::BooleanLiteral*>(node);
+			this->chunk->emit(literal->value ? OpCode::True : OpCode::False);
+			break;
+		}
+		case interp::ast::NodeType::CallExpression:
+		{
+			auto literal = static_cast<interp::ast::CallExpression*>(node);
+			this->compile_node(literal->function);
+			for (auto arg : literal->args)
+			{
+				this->compile_node(arg);
+			}
+			this->chunk->emit(literal->tail ? OpCode::TailCall : OpCode::Call);
+			this->chunk->emit_operand(static_cast<uint32_t>(literal->args.size()));
+			break;
+		}
+		case interp::ast::NodeType::ExpressionStatment:
+		{
+			auto literal = static_cast<interp::ast::ExpressionStatement*>(node);
+			this->compile_node(literal->expression);
+			break;
+		}
+		case interp::ast::NodeType::ForExpression:
+		{
+			// The array and the next index stay on the stack for the whole loop
+			auto literal = static_cast<interp::ast::ForExpression*>(node);
+			this->compile_node(literal->iterable);
+			this->chunk->emit(OpCode::SmallInt);
+			this->chunk->emit_operand(0);
+			if (!literal->captures)
+			{
+				this->chunk->emit(OpCode::PushEnv);
+				this->chunk->emit_operand(literal->locals);
+			}
+
+			auto loop_start = static_cast<uint32_t>(this->chunk->code.size());
+			auto to_end = this->emit_jump(OpCode::ForNext);
+			if (literal->captures)
+			{
+				this->chunk->emit(OpCode::PushEnv);
+				this->chunk->emit_operand(literal->locals);
+			}
+			this->chunk->emit(OpCode::SetVar);
+			this->chunk->emit_operand(literal->variable.slot);
+			this->chunk->emit(OpCode::Pop);
+			this->compile_loop_body(literal->body, literal->captures, loop_start);
+
+			this->patch_jump(to_end);
+			if (!literal->captures)
+				this->chunk->emit(OpCode::PopEnv);
+			this->chunk->emit(OpCode::Null);
+			break;
+		}
+		case interp::ast::NodeType::FunctionLiteral:
+		{
+			this->compile_function(static_cast<interp::ast::FunctionLiteral*>(node));
+			break;
+		}
+		case interp::ast::NodeType::HashLiteral:
+		{
+			auto literal = static_cast<interp::ast::HashLiteral*>(node);
+			for (auto& [key, value] : literal->pairs)
+			{
+				this->compile_node(key);
+				this->compile_node(value);
+			}
+			this->chunk->emit(OpCode::Hash);
+			this->chunk->emit_operand(static_cast<uint32_t>(literal->pairs.size() * 2));
+			break;
+		}
+		case interp::ast::NodeType::Identifier:
+		{
+			this->compile_variable(OpCode::GetVar, static_cast<interp::ast::Identifier*>(node));
+			break;
+		}
+		case interp::ast::NodeType::IfExpression:
+		{
+			auto literal = static_cast<interp::ast::IfExpression*>(node);
+			this->compile_node(literal->condition);
+			auto to_alternative = this->emit_jump(OpCode::JumpIfFalse);
+			this->compile_node(literal->consequence);
+			auto to_end = this->emit_jump(OpCode::Jump);
+
+			this->patch_jump(to_alternative);
+			if (literal->alternative)
+				this->compile_node(literal->alternative);
+			else
+				this->chunk->emit(OpCode::Null);
+			this->patch_jump(to_end);
+			break;
+		}
+		case interp::ast::NodeType::IndexExpression:
+		{
+			auto literal = static_cast<interp::ast::IndexExpression*>(node);
+			this->compile_node(literal->left);
+			this->compile_node(literal->index);
+			this->chunk->emit(OpCode::Index);
+			break;
+		}
+		case interp::ast::NodeType::InfixExpression:
+		{
+			auto literal = static_cast<interp::ast::InfixExpression*>(node);
+			this->compile_node(literal->left);
+			this->compile_node(literal->right);
+			this->chunk->emit(OpCode::Infix);
+			this->chunk->emit_operand(static_cast<uint32_t>(literal->op));
+			break;
+		}
+		case interp::ast::NodeType::IntegerLiteral:
+		{
+			auto literal = static_cast<interp::ast::IntegerLiteral*>(node);
+			if (literal->value >= SMALL_INT_MIN && literal->value <= SMALL_INT_MAX)
+			{
+				this->chunk->emit(OpCode::SmallInt);
+				this->chunk->emit_operand(static_cast<uint32_t>(static_cast<int32_t>(literal->value)));
+				break;
+			}
+			this->chunk->emit(OpCode::Constant);
+			this->chunk->emit_operand(this->add_constant(interp::object::Value::integer(literal->value)));
+			break;
+		}
+		case interp::ast::NodeType::LetStatment:
+		{
+			auto literal = static_cast<interp::ast::LetStatement*>(node);
+			this->compile_node(literal->value);
+			this->chunk->emit(OpCode::SetVar);
+			this->chunk->emit_operand(literal->name.slot);
+			break;
+		}
+		case interp::ast::NodeType::PrefixExpression:
+		{
+			auto literal = static_cast<interp::ast::PrefixExpression*>(node);
+			this->compile_node(literal->right);
+			this->chunk->emit(OpCode::Prefix);
+			this->chunk->emit_operand(static_cast<uint32_t>(literal->op));
+			break;
+		}
+		case interp::ast::NodeType::ReturnStatment:
+		{
+			auto literal = static_cast<interp::ast::ReturnStatement*>(node);
+			this->compile_node(literal->return_value);
+			this->chunk->emit(OpCode::Return);
+			break;
+		}
+		case interp::ast::NodeType::StringLiteral:
+		{
+			// Strings are immutable, so every evaluation can share one object
+			auto literal = static_cast<interp::ast::StringLiteral*>(node);
+			this->chunk->emit(OpCode::Constant);
+			this->chunk->emit_operand(this->add_constant(literal->cached
+				? literal->cached
+				: interp::object::pool::make<interp::object::StringObject>(literal->value)));
+			break;
+		}
+		case interp::ast::NodeType::WhileExpression:
+		{
+			// The loop's environment is entered once, or once per iteration
+			// when the body makes functions that could keep it
+			auto literal = static_cast<interp::ast::WhileExpression*>(node);
+			if (!literal->captures)
+			{
+				this->chunk->emit(OpCode::PushEnv);
+				this->chunk->emit_operand(literal->locals);
+			}
+
+			auto loop_start = static_cast<uint32_t>(this->chunk->code.size());
+			if (literal->captures)
+			{
+				this->chunk->emit(OpCode::PushEnv);
+				this->chunk->emit_operand(literal->locals);
+			}
+			this->compile_node(literal->condition);
+			auto to_end = this->emit_jump(OpCode::JumpIfFalse);
+			this->compile_loop_body(literal->body, literal->captures, loop_start);
+
+			this->patch_jump(to_end);
+			this->chunk->emit(OpCode::PopEnv);
+			this->chunk->emit(OpCode::Null);
+			break;
+		}
+		default:
+			this->chunk->emit(OpCode::Null);
+			break;
+		}
+	}
+
+	// Leaves the value of the last statement on the stack, or null if there
+	// are none.
+	void Compiler::compile_statements(std::vector<interp::ast::Statement*>& statements)
+	{
+		if (statements.empty())
+		{
+			this->chunk->emit(OpCode::Null);
+			return;
+		}
+
+		for (size_t i = 0; i < statements.size(); i++)
+		{
+			if (i > 0)
+				this->chunk->emit(OpCode::Pop);
+			this->compile_node(statements[i]);
+		}
+	}
+
+	// Runs the body's statements for their effects and jumps back to
+	// loop_start, leaving an environment entered per iteration first.
+	void Compiler::compile_loop_body(interp::ast::BlockExpression* body, bool captures, uint32_t loop_start)
+	{
+		for (auto statement : body->statements)
+		{
+			this->compile_node(statement);
+			this->chunk->emit(OpCode::Pop);
+		}
+		if (captures)
+			this->chunk->emit(OpCode::PopEnv);
+		this->chunk->emit(OpCode::Jump);
+		this->chunk->emit_operand(loop_start);
+	}
+
+	// GetVar or Assign, which share their operands
+	void Compiler::compile_variable(OpCode op, interp::ast::Identifier* ident)
+	{
+		this->chunk->emit(op);
+		this->chunk->emit_operand(ident->depth);
+		this->chunk->emit_operand(ident->slot);
+		this->chunk->emit_operand(this->add_name(ident->name));
+	}
+
+	void Compiler::compile_function(interp::ast::FunctionLiteral* literal)
+	{
+		auto proto = std::shared_ptr<FunctionProto>(new FunctionProto());
+		proto->literal = literal;
+
+		auto enclosing = this->chunk;
+		auto enclosing_names = std::move(this->name_indices);
+		this->chunk = &proto->chunk;
+		this->name_indices.clear();
+		this->compile_node(literal->body);
+		this->chunk->emit(OpCode::Return);
+		this->chunk = enclosing;
+		this->name_indices = std::move(enclosing_names);
+
+		this->chunk->emit(OpCode::Closure);
+		this->chunk->emit_operand(static_cast<uint32_t>(this->chunk->functions.size()));
+		this->chunk->functions.push_back(proto);
+	}
+
+	uint32_t Compiler::add_constant(interp::object::Value value)
+	{
+		this->chunk->constants.push_back(std::move(value));
+		return static_cast<uint32_t>(this->chunk->constants.size() - 1);
+	}
+
+	// Each name is stored once per chunk, however often it is used.
+	uint32_t Compiler::add_name(interp::lexer::Atom name)
+	{
+		auto [it, inserted] = this->name_indices.try_emplace(name, static_cast<uint32_t>(this->chunk->names.size()));
+		if (inserted)
+			this->chunk->names.push_back(name);
+		return it->second;
+	}
+
+	// Returns the offset of the jump's target operand for patch_jump.
+	size_t Compiler::emit_jump(OpCode op)
+	{
+		this->chunk->emit(op);
+		auto operand = this->chunk->code.size();
+		this->chunk->emit_operand(0);
+		return operand;
+	}
+
+	// Points the jump at the next instruction to be emitted.
+	void Compiler::patch_jump(size_t operand)
+	{
+		this->chunk->patch_operand(operand, static_cast<uint32_t>(this->chunk->code.size()));
+	}
+}
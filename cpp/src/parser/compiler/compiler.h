@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "ast.h"
+#include "code.h"
+
+namespace interp::compiler
+{
+	// Lowers a resolved program to bytecode for the VM. Variables keep the
+	// (depth, slot) addresses the resolver gave them, so compiled code and
+	// the tree walker share environments and function objects.
+	class Compiler
+	{
+	public:
+		Compiler() = default;
+		~Compiler() = default;
+
+		std::shared_ptr<const FunctionProto> compile(interp::ast::Program* program);
+
+	private:
+		Chunk* chunk = nullptr;
+		// Index of each name already in chunk->names
+		std::unordered_map<interp::lexer::Atom, uint32_t, interp::lexer::Atom::Hash> name_indices;
+
+		void compile_node(interp::ast::Node* node);
+		void compile_statements(std::vector<interp::ast::Statement*>& statements);
+		void compile_loop_body(interp::ast::BlockExpression* body, bool captures, uint32_t loop_start);
+		void compile_variable(OpCode op, interp::ast::Identifier* ident);
+		void compile_function(interp::ast::FunctionLiteral* literal);
+		uint32_t add_constant(interp::object::Value value);
+		uint32_t add_name(interp::lexer::Atom name);
+		size_t emit_jump(OpCode op);
+		void patch_jump(size_t operand);
+	};
+}
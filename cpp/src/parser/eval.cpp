@@ -1,160 +1,210 @@
+#include <array>
+#include <limits>
+
 #include "eval.h"
-#include "builtins/builtins.h"
+#include "folder.h"
+#include "resolver.h"
 
 namespace interp::eval
 {
-	auto TRUE = std::shared_ptr<interp::object::BooleanObject>(new interp::object::BooleanObject(true));
-	auto FALSE = std::shared_ptr<interp::object::BooleanObject>(new interp::object::BooleanObject(false));
-	auto NULL_OBJ = std::shared_ptr<interp::object::Null>(new interp::object::Null());
+	const auto TRUE = interp::object::Value::boolean(true);
+	const auto FALSE = interp::object::Value::boolean(false);
+	const auto NULL_OBJ = interp::object::Value::null();
 
-	std::shared_ptr<interp::object::Object> eval(std::shared_ptr<interp::ast::Node> node, std::shared_ptr<interp::object::Environment>& env)
+	interp::object::Value eval(interp::ast::Node* node, interp::object::Ref<interp::object::Environment>& env)
 	{
 		switch (node->type())
 		{
 		case interp::ast::NodeType::Program:
-			if (auto literal = dynamic_cast<interp::ast::Program*>(node.get()))
-			{
-				return eval_statments(literal->statements, env, true);
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::Program*>(node);
+			interp::parser::Folder(*literal->arena).fold(literal);
+			interp::parser::Resolver(*env).resolve(literal);
+			return eval_statments(literal->statements, env, true);
+		}
+		case interp::ast::NodeType::ArrayLiteral:
+		{
+			auto literal = static_cast<interp::ast::ArrayLiteral*>(node);
+			auto elements = eval_expressions(literal->elements, env);
+			if (elements.size() == 1 && is_error(elements[0]))
+				return elements[0];
+			return interp::object::pool::make<interp::object::ArrayObject>(std::move(elements));
+		}
+		case interp::ast::NodeType::AssignExpression:
+		{
+			auto literal = static_cast<interp::ast::AssignExpression*>(node);
+			auto value = eval(literal->value, env);
+			if (is_error(value))
+				return value;
+
+			if (!env->assign(literal->name->depth, literal->name->slot, value))
+				return new_error("identifier not found: " + literal->name->value);
+			return value;
+		}
 		case interp::ast::NodeType::BlockExpression:
-			if (auto literal = dynamic_cast<interp::ast::BlockExpression*>(node.get()))
-			{
-				auto new_env = interp::object::Environment::new_env(env);
-				return eval_statments(literal->statements, new_env);
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::BlockExpression*>(node);
+			if (!literal->own_env)
+				return eval_statments(literal->statements, env);
+			auto new_env = interp::object::Environment::new_env(env, literal->locals);
+			return eval_statments(literal->statements, new_env);
+		}
 		case interp::ast::NodeType::BooleanExpression:
-			if (auto literal = dynamic_cast<interp::ast::BooleanLiteral*>(node.get()))
-			{
-				return literal->value ? TRUE : FALSE;
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::BooleanLiteral*>(node);
+			return literal->value ? TRUE : FALSE;
+		}
 		case interp::ast::NodeType::CallExpression:
-			if (auto literal = dynamic_cast<interp::ast::CallExpression*>(node.get()))
-			{
-				auto fn = eval(literal->function, env);
-				if (is_error(fn))
-					return fn;
+		{
+			auto literal = static_cast<interp::ast::CallExpression*>(node);
+			auto fn = eval(literal->function, env);
+			if (is_error(fn))
+				return fn;
 
-				auto args = eval_expressions(literal->args, env);
-				if (args.size() == 1 && is_error(args[0]))
-					return args[0];
+			auto args = eval_expressions(literal->args, env);
+			if (args.size() == 1 && is_error(args[0]))
+				return args[0];
 
-				return apply_fn(fn, args);
-			}
-			return nullptr;
+			if (literal->tail)
+				return interp::object::nursery::make<interp::object::TailCallObject>(std::move(fn), std::move(args));
+
+			return apply_fn(fn, args);
+		}
 		case interp::ast::NodeType::ExpressionStatment:
-			if (auto literal = dynamic_cast<interp::ast::ExpressionStatement*>(node.get()))
-			{
-				return eval(literal->expression, env);
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::ExpressionStatement*>(node);
+			return eval(literal->expression, env);
+		}
+		case interp::ast::NodeType::ForExpression:
+		{
+			auto literal = static_cast<interp::ast::ForExpression*>(node);
+			return eval_for(literal, env);
+		}
 		case interp::ast::NodeType::FunctionLiteral:
-			if (auto literal = dynamic_cast<interp::ast::FunctionLiteral*>(node.get()))
-			{
-				return std::shared_ptr<interp::object::FunctionObject>(
-					new interp::object::FunctionObject(literal, env) );
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::FunctionLiteral*>(node);
+			return interp::object::pool::make<interp::object::FunctionObject>(literal, env);
+		}
 		case interp::ast::NodeType::Identifier:
-			if (auto literal = dynamic_cast<interp::ast::Identifier*>(node.get()))
-			{
-				auto obj = env->get(literal->value);
+		{
+			auto literal = static_cast<interp::ast::Identifier*>(node);
+			auto obj = env->get(literal->depth, literal->slot);
 
-				if (obj)
-					return obj;
-				else
-					return new_error("identifier not found: " + literal->value);
-			}
-			return nullptr;
-		case interp::ast::NodeType::IfExpression:
-			if (auto literal = dynamic_cast<interp::ast::IfExpression*>(node.get()))
+			if (obj)
+				return obj;
+			else
+				return new_error("identifier not found: " + literal->value);
+		}
+		case interp::ast::NodeType::HashLiteral:
+		{
+			auto literal = static_cast<interp::ast::HashLiteral*>(node);
+			std::vector<interp::object::Value> keys_and_values;
+			keys_and_values.reserve(literal->pairs.size() * 2);
+			for (auto& [key, value] : literal->pairs)
 			{
-				return eval_if(literal, env);
+				for (auto expr : { key, value })
+				{
+					auto evaled = eval(expr, env);
+					if (is_error(evaled))
+						return evaled;
+					keys_and_values.push_back(std::move(evaled));
+				}
 			}
-			return nullptr;
+			return eval_hash(keys_and_values);
+		}
+		case interp::ast::NodeType::IfExpression:
+		{
+			auto literal = static_cast<interp::ast::IfExpression*>(node);
+			return eval_if(literal, env);
+		}
+		case interp::ast::NodeType::IndexExpression:
+		{
+			auto literal = static_cast<interp::ast::IndexExpression*>(node);
+			auto left = eval(literal->left, env);
+			if (is_error(left))
+				return left;
+			auto index = eval(literal->index, env);
+			if (is_error(index))
+				return index;
+			return eval_index(left, index);
+		}
 		case interp::ast::NodeType::InfixExpression:
-			if (auto literal = dynamic_cast<interp::ast::InfixExpression*>(node.get()))
-			{
-				auto left = eval(literal->left, env);
-				if (is_error(left))
-					return left;
-				auto right = eval(literal->right, env);
-				if (is_error(right))
-					return right;
-				return eval_infix(literal->p_operator, left, right);
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::InfixExpression*>(node);
+			auto left = eval(literal->left, env);
+			if (is_error(left))
+				return left;
+			auto right = eval(literal->right, env);
+			if (is_error(right))
+				return right;
+			return eval_infix(literal->op, left, right);
+		}
 		case interp::ast::NodeType::IntegerLiteral:
-			if (auto literal = dynamic_cast<interp::ast::IntegerLiteral*>(node.get()))
-			{
-
-				return std::shared_ptr<interp::object::Integer>(new interp::object::Integer(literal->value));
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::IntegerLiteral*>(node);
+			return interp::object::Value::integer(literal->value);
+		}
 		case interp::ast::NodeType::LetStatment:
-			if (auto literal = dynamic_cast<interp::ast::LetStatement*>(node.get()))
-			{
-				auto inner = eval(literal->value, env);
-				if (is_error(inner))
-					return inner;
+		{
+			auto literal = static_cast<interp::ast::LetStatement*>(node);
+			auto inner = eval(literal->value, env);
+			if (is_error(inner))
+				return inner;
 
-				return env->set(literal->name.value, inner);
-			}
-			return nullptr;
+			return env->set(literal->name.slot, inner);
+		}
 		case interp::ast::NodeType::PrefixExpression:
-			if (auto literal = dynamic_cast<interp::ast::PrefixExpression*>(node.get()))
-			{
-				auto right = eval(literal->right, env);
-				if (is_error(right))
-					return right;
-				return eval_prefix(literal->p_operator, right);
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::PrefixExpression*>(node);
+			auto right = eval(literal->right, env);
+			if (is_error(right))
+				return right;
+			return eval_prefix(literal->op, right);
+		}
 		case interp::ast::NodeType::ReturnStatment:
-			if (auto literal = dynamic_cast<interp::ast::ReturnStatement*>(node.get()))
-			{
-				auto inner = eval(literal->return_value, env);
-				if (is_error(inner))
-					return inner;
-				return std::shared_ptr<interp::object::ReturnObject>(
-					new interp::object::ReturnObject( inner ));
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::ReturnStatement*>(node);
+			auto inner = eval(literal->return_value, env);
+			if (is_error(inner))
+				return inner;
+			return interp::object::nursery::make<interp::object::ReturnObject>(std::move(inner));
+		}
 		case interp::ast::NodeType::StringLiteral:
-			if (auto literal = dynamic_cast<interp::ast::StringLiteral*>(node.get()))
-			{
-				return std::shared_ptr<interp::object::StringObject>(
-					new interp::object::StringObject( literal->value ));
-			}
-			return nullptr;
+		{
+			auto literal = static_cast<interp::ast::StringLiteral*>(node);
+			if (literal->cached)
+				return literal->cached;
+			return interp::object::nursery::make<interp::object::StringObject>(literal->value);
+		}
+		case interp::ast::NodeType::WhileExpression:
+		{
+			auto literal = static_cast<interp::ast::WhileExpression*>(node);
+			return eval_while(literal, env);
+		}
 		default:
-			return nullptr;
+			return interp::object::Value();
 		}
 	}
 
-	std::shared_ptr<interp::object::Object> eval_statments(std::vector<std::shared_ptr<interp::ast::Statement>>& statements, std::shared_ptr<interp::object::Environment>& env, bool unwrap_return)
+	interp::object::Value eval_statments(std::vector<interp::ast::Statement*>& statements, interp::object::Ref<interp::object::Environment>& env, bool unwrap_return)
 	{
-		std::shared_ptr<interp::object::Object> result = nullptr;
+		// A block without statements is null, a program without any is empty
+		interp::object::Value result = unwrap_return ? interp::object::Value() : NULL_OBJ;
 
 		for (auto& statement : statements)
 		{
 			result = eval(statement, env);
 
-			if (result->type() == interp::object::ObjectType::ReturnObject)
+			if (result.type() == interp::object::ObjectType::ReturnObject)
 			{
 				if (!unwrap_return)
 				{
 					return result;
 				}
 
-				if (auto r_obj = dynamic_cast<interp::object::ReturnObject*>(result.get()))
-				{
-					return r_obj->value;
-				}
+				return result.as<interp::object::ReturnObject>()->value;
 			}
-			else if (result->type() == interp::object::ObjectType::ErrorObject)
+			else if (result.type() == interp::object::ObjectType::ErrorObject)
 			{
 				return result;
 			}
@@ -163,9 +213,10 @@ namespace interp::eval
 		return result;
 	}
 
-	std::vector<std::shared_ptr<interp::object::Object>> eval_expressions(std::vector<std::shared_ptr<interp::ast::Expression>>& expressions, std::shared_ptr<interp::object::Environment>& env)
+	std::vector<interp::object::Value> eval_expressions(std::vector<interp::ast::Expression*>& expressions, interp::object::Ref<interp::object::Environment>& env)
 	{
-		std::vector<std::shared_ptr<interp::object::Object>> results({});
+		std::vector<interp::object::Value> results;
+		results.reserve(expressions.size());
 
 		for (auto& expr : expressions)
 		{
@@ -184,26 +235,12 @@ namespace interp::eval
 		return results;
 	}
 
-	std::shared_ptr<interp::object::Object> eval_prefix(std::string& op, std::shared_ptr<interp::object::Object>& right)
+	interp::object::Value eval_bang(const interp::object::Value& right)
 	{
-		if (op == "!")
-			return eval_bang(right);
-		else if (op == "-")
-			return eval_minus(right);
-		else
-			return new_error("unknown operator: " + op + interp::object::object_type_to_string(right->type()));
-	}
-
-	std::shared_ptr<interp::object::Object> eval_bang(std::shared_ptr<interp::object::Object>& right)
-	{
-		switch (right->type())
+		switch (right.type())
 		{
 		case interp::object::ObjectType::BooleanObject:
-			if (auto bool_obj = dynamic_cast<interp::object::BooleanObject*>(right.get()))
-			{
-				return bool_obj->value ? FALSE : TRUE;
-			}
-			[[fallthrough]];
+			return right.as_boolean() ? FALSE : TRUE;
 		case interp::object::ObjectType::NullObject:
 			return TRUE;
 		default:
@@ -211,109 +248,227 @@ namespace interp::eval
 		}
 	}
 
-	std::shared_ptr<interp::object::Object> eval_minus(std::shared_ptr<interp::object::Object>& right)
+	interp::object::Value eval_minus(const interp::object::Value& right)
 	{
-		switch (right->type())
+		switch (right.type())
 		{
 		case interp::object::ObjectType::IntegerObject:
-			if (auto int_obj = dynamic_cast<interp::object::Integer*>(right.get()))
-			{
-				return std::shared_ptr<interp::object::Integer>(new interp::object::Integer(-int_obj->value));
-			}
-			[[fallthrough]];
+			if (right.as_integer() == std::numeric_limits<int64_t>::min())
+				return new_error("integer overflow: -(" + std::to_string(right.as_integer()) + ")");
+			return interp::object::Value::integer(-right.as_integer());
 		default:
-			return new_error("unknown operator: -" + interp::object::object_type_to_string(right->type()));
+			return new_error("unknown operator: -" + interp::object::object_type_to_string(right.type()));
 		}
 	}
 
-	std::shared_ptr<interp::object::Object> eval_infix(std::string& op, std::shared_ptr<interp::object::Object>& left, std::shared_ptr<interp::object::Object>& right)
+	typedef interp::object::Value (*PrefixFn)(interp::ast::Operator op, const interp::object::Value& right);
+	typedef interp::object::Value (*InfixFn)(interp::ast::Operator op, const interp::object::Value& left, const interp::object::Value& right);
+
+	interp::object::Value unknown_prefix(interp::ast::Operator op, const interp::object::Value& right)
 	{
-		if (left->type() != right->type())
-			return new_error("type mismatch: "
-				+ interp::object::object_type_to_string(left->type())
-				+ " " + op + " "
-				+ interp::object::object_type_to_string(right->type()));
-		else if (right->type() == interp::object::ObjectType::IntegerObject)
-			return eval_int_infix(op, left, right);
-		if (right->type() == interp::object::ObjectType::StringObject)
-			return eval_string_infix(op, left, right);
-		else if (op == "==")
-			return left == right ? TRUE : FALSE;
-		else if (op == "!=")
-			return left != right ? TRUE : FALSE;
+		return new_error("unknown operator: " + interp::ast::operator_to_string(op) + interp::object::object_type_to_string(right.type()));
+	}
+
+	interp::object::Value type_mismatch(interp::ast::Operator op, const interp::object::Value& left, const interp::object::Value& right)
+	{
+		return new_error("type mismatch: "
+			+ interp::object::object_type_to_string(left.type())
+			+ " " + interp::ast::operator_to_string(op) + " "
+			+ interp::object::object_type_to_string(right.type()));
+	}
+
+	interp::object::Value unknown_infix(interp::ast::Operator op, const interp::object::Value& left, const interp::object::Value& right)
+	{
+		return new_error("unknown operator: "
+			+ interp::object::object_type_to_string(left.type())
+			+ " " + interp::ast::operator_to_string(op) + " "
+			+ interp::object::object_type_to_string(right.type()));
+	}
+
+	// Booleans and null compare by value, every other type without its own
+	// comparison by identity.
+	interp::object::Value identity_equal(interp::ast::Operator op, const interp::object::Value& left, const interp::object::Value& right)
+	{
+		return left.identical(right) == (op == interp::ast::Operator::Equal) ? TRUE : FALSE;
+	}
+
+	interp::object::Value integer_overflow(interp::ast::Operator op, int64_t left, int64_t right)
+	{
+		return new_error("integer overflow: " + std::to_string(left) + " " + interp::ast::operator_to_string(op) + " " + std::to_string(right));
+	}
+
+	// The infix table only points here once both operands are known to be
+	// integers. Results that do not fit in 64 bits are errors.
+	template <interp::ast::Operator Op>
+	interp::object::Value int_infix(interp::ast::Operator op, const interp::object::Value& left, const interp::object::Value& right)
+	{
+		using interp::ast::Operator;
+
+		auto left_value = left.as_integer();
+		auto right_value = right.as_integer();
+
+		if constexpr (Op == Operator::Plus)
+		{
+			int64_t result;
+			if (__builtin_add_overflow(left_value, right_value, &result))
+				return integer_overflow(op, left_value, right_value);
+			return interp::object::Value::integer(result);
+		}
+		else if constexpr (Op == Operator::Minus)
+		{
+			int64_t result;
+			if (__builtin_sub_overflow(left_value, right_value, &result))
+				return integer_overflow(op, left_value, right_value);
+			return interp::object::Value::integer(result);
+		}
+		else if constexpr (Op == Operator::Asterisk)
+		{
+			int64_t result;
+			if (__builtin_mul_overflow(left_value, right_value, &result))
+				return integer_overflow(op, left_value, right_value);
+			return interp::object::Value::integer(result);
+		}
+		else if constexpr (Op == Operator::ForwardSlash)
+		{
+			if (right_value == 0)
+				return new_error("division by zero");
+			// The quotient is one past INT64_MAX, which the hardware traps on
+			if (left_value == std::numeric_limits<int64_t>::min() && right_value == -1)
+				return integer_overflow(op, left_value, right_value);
+			return interp::object::Value::integer(left_value / right_value);
+		}
+		else if constexpr (Op == Operator::LessThan)
+			return left_value < right_value ? TRUE : FALSE;
+		else if constexpr (Op == Operator::LessThanOrEqual)
+			return left_value <= right_value ? TRUE : FALSE;
+		else if constexpr (Op == Operator::GreaterThan)
+			return left_value > right_value ? TRUE : FALSE;
+		else if constexpr (Op == Operator::GreaterThanOrEqual)
+			return left_value >= right_value ? TRUE : FALSE;
+		else if constexpr (Op == Operator::Equal)
+			return left_value == right_value ? TRUE : FALSE;
+		else if constexpr (Op == Operator::NotEqual)
+			return left_value != right_value ? TRUE : FALSE;
 		else
-			return new_error("unknown operator: " 
-				+ interp::object::object_type_to_string(left->type())
-				+ " " + op + " "
-				+ interp::object::object_type_to_string(right->type()));
+			return unknown_infix(op, left, right);
+	}
+
+	// The infix table only points here once both operands are known to be strings
+	interp::object::Value string_concat(interp::ast::Operator, const interp::object::Value& left, const interp::object::Value& right)
+	{
+		return interp::object::StringObject::concat(
+			interp::object::Ref<interp::object::StringObject>(left.as<interp::object::StringObject>()),
+			interp::object::Ref<interp::object::StringObject>(right.as<interp::object::StringObject>()));
 	}
 
-	std::shared_ptr<interp::object::Object> eval_int_infix(std::string& op, std::shared_ptr<interp::object::Object>& left, std::shared_ptr<interp::object::Object>& right)
+	// Handlers indexed by [operator][operand type], resolved once at startup
+	// so evaluating a prefix expression is a single indirect call.
+	typedef std::array<std::array<PrefixFn, interp::object::OBJECT_TYPE_COUNT>, interp::ast::OPERATOR_COUNT> PrefixTable;
+	const PrefixTable prefix_fns = []
 	{
-		if (auto right_obj = dynamic_cast<interp::object::Integer*>(right.get()))
+		using interp::ast::Operator;
+		using interp::object::ObjectType;
+
+		PrefixTable fns;
+		for (auto& by_type : fns)
+			by_type.fill(unknown_prefix);
+
+		fns[static_cast<size_t>(Operator::Bang)].fill([](Operator, const interp::object::Value& right)
+			{ return eval_bang(right); });
+		fns[static_cast<size_t>(Operator::Minus)][static_cast<size_t>(ObjectType::IntegerObject)] = [](Operator, const interp::object::Value& right)
+			{ return eval_minus(right); };
+
+		return fns;
+	}();
+
+	// Handlers indexed by [operator][left type][right type].
+	typedef std::array<std::array<std::array<InfixFn, interp::object::OBJECT_TYPE_COUNT>, interp::object::OBJECT_TYPE_COUNT>, interp::ast::OPERATOR_COUNT> InfixTable;
+	const InfixTable infix_fns = []
+	{
+		using interp::ast::Operator;
+		using interp::object::ObjectType;
+
+		InfixTable fns;
+		for (size_t op = 0; op < interp::ast::OPERATOR_COUNT; op++)
 		{
-			if (auto left_obj = dynamic_cast<interp::object::Integer*>(left.get()))
+			bool is_equality = op == static_cast<size_t>(Operator::Equal) || op == static_cast<size_t>(Operator::NotEqual);
+			for (size_t left = 0; left < interp::object::OBJECT_TYPE_COUNT; left++)
 			{
-				int64_t result = 0;
-				if (op == "-")
-					result = left_obj->value - right_obj->value;
-				else if (op == "+")
-					result = left_obj->value + right_obj->value;
-				else if (op == "*")
-					result = left_obj->value * right_obj->value;
-				else if (op == "/")
-					result = left_obj->value / right_obj->value;
-				else if (op == "<")
-					return left_obj->value < right_obj->value ? TRUE : FALSE;
-				else if (op == ">")
-					return left_obj->value > right_obj->value ? TRUE : FALSE;
-				else if (op == "<=")
-					return left_obj->value <= right_obj->value ? TRUE : FALSE;
-				else if (op == ">=")
-					return left_obj->value >= right_obj->value ? TRUE : FALSE;
-				else if (op == "==")
-					return left_obj->value == right_obj->value ? TRUE : FALSE;
-				else if (op == "!=")
-					return left_obj->value != right_obj->value ? TRUE : FALSE;
-				else
-					return new_error("unknown operator: "
-						+ interp::object::object_type_to_string(left_obj->type())
-						+ " " + op + " "
-						+ interp::object::object_type_to_string(right_obj->type()));
-				
-				return std::shared_ptr<interp::object::Integer>(new interp::object::Integer(result));
+				for (size_t right = 0; right < interp::object::OBJECT_TYPE_COUNT; right++)
+				{
+					if (left != right)
+						fns[op][left][right] = type_mismatch;
+					else
+						fns[op][left][right] = is_equality ? identity_equal : unknown_infix;
+				}
 			}
 		}
-		
-		return new_error("unknown operator: "
-			+ interp::object::object_type_to_string(left->type())
-			+ " " + op + " "
-			+ interp::object::object_type_to_string(right->type()));
+
+		constexpr auto integer = static_cast<size_t>(ObjectType::IntegerObject);
+		fns[static_cast<size_t>(Operator::Plus)][integer][integer] = int_infix<Operator::Plus>;
+		fns[static_cast<size_t>(Operator::Minus)][integer][integer] = int_infix<Operator::Minus>;
+		fns[static_cast<size_t>(Operator::Asterisk)][integer][integer] = int_infix<Operator::Asterisk>;
+		fns[static_cast<size_t>(Operator::ForwardSlash)][integer][integer] = int_infix<Operator::ForwardSlash>;
+		fns[static_cast<size_t>(Operator::LessThan)][integer][integer] = int_infix<Operator::LessThan>;
+		fns[static_cast<size_t>(Operator::LessThanOrEqual)][integer][integer] = int_infix<Operator::LessThanOrEqual>;
+		fns[static_cast<size_t>(Operator::GreaterThan)][integer][integer] = int_infix<Operator::GreaterThan>;
+		fns[static_cast<size_t>(Operator::GreaterThanOrEqual)][integer][integer] = int_infix<Operator::GreaterThanOrEqual>;
+		fns[static_cast<size_t>(Operator::Equal)][integer][integer] = int_infix<Operator::Equal>;
+		fns[static_cast<size_t>(Operator::NotEqual)][integer][integer] = int_infix<Operator::NotEqual>;
+
+		// Strings only support concatenation, not even equality.
+		constexpr auto string = static_cast<size_t>(ObjectType::StringObject);
+		for (auto& by_left : fns)
+			by_left[string][string] = unknown_infix;
+		fns[static_cast<size_t>(Operator::Plus)][string][string] = string_concat;
+
+		return fns;
+	}();
+
+	interp::object::Value eval_prefix(interp::ast::Operator op, const interp::object::Value& right)
+	{
+		return prefix_fns[static_cast<size_t>(op)][static_cast<size_t>(right.type())](op, right);
+	}
+
+	interp::object::Value eval_infix(interp::ast::Operator op, const interp::object::Value& left, const interp::object::Value& right)
+	{
+		return infix_fns[static_cast<size_t>(op)][static_cast<size_t>(left.type())][static_cast<size_t>(right.type())](op, left, right);
 	}
-	
-	std::shared_ptr<interp::object::Object> eval_string_infix(std::string& op, std::shared_ptr<interp::object::Object>& left, std::shared_ptr<interp::object::Object>& right)
+
+	interp::object::Value eval_hash(std::span<const interp::object::Value> keys_and_values)
 	{
-		if (auto right_obj = dynamic_cast<interp::object::StringObject*>(right.get()))
+		for (size_t i = 0; i < keys_and_values.size(); i += 2)
 		{
-			if (auto left_obj = dynamic_cast<interp::object::StringObject*>(left.get()))
-			{
-				if (op == "+")
-					return std::shared_ptr<interp::object::StringObject>(new interp::object::StringObject(left_obj->value + right_obj->value));
-				else
-					return new_error("unknown operator: "
-						+ interp::object::object_type_to_string(left_obj->type())
-						+ " " + op + " "
-						+ interp::object::object_type_to_string(right_obj->type()));
-			}
+			if (!interp::object::is_hashable(keys_and_values[i]))
+				return new_error("unusable as hash key: " + interp::object::object_type_to_string(keys_and_values[i].type()));
 		}
-		
-		return new_error("unknown operator: "
-			+ interp::object::object_type_to_string(left->type())
-			+ " " + op + " "
-			+ interp::object::object_type_to_string(right->type()));
+		return interp::object::pool::make<interp::object::HashObject>(keys_and_values);
+	}
+
+	// Indexing outside an array or with a missing key is null, not an error
+	interp::object::Value eval_index(const interp::object::Value& left, const interp::object::Value& index)
+	{
+		if (left.type() == interp::object::ObjectType::ArrayObject && index.type() == interp::object::ObjectType::IntegerObject)
+		{
+			auto elements = left.as<interp::object::ArrayObject>()->elements();
+			auto i = index.as_integer();
+			if (i < 0 || static_cast<uint64_t>(i) >= elements.size())
+				return NULL_OBJ;
+			return elements[i];
+		}
+
+		if (left.type() == interp::object::ObjectType::HashObject)
+		{
+			if (!interp::object::is_hashable(index))
+				return new_error("unusable as hash key: " + interp::object::object_type_to_string(index.type()));
+			auto value = left.as<interp::object::HashObject>()->get(index);
+			return value ? *value : NULL_OBJ;
+		}
+
+		return new_error("index operator not supported: " + interp::object::object_type_to_string(left.type()));
 	}
 
-	std::shared_ptr<interp::object::Object> eval_if(interp::ast::IfExpression* ifExpr, std::shared_ptr<interp::object::Environment>& env)
+	interp::object::Value eval_if(interp::ast::IfExpression* ifExpr, interp::object::Ref<interp::object::Environment>& env)
 	{
 		auto condition = eval(ifExpr->condition, env);
 		if (is_error(condition))
@@ -333,37 +488,116 @@ namespace interp::eval
 		}
 	}
 
-	std::shared_ptr<interp::object::Object> apply_fn(std::shared_ptr<interp::object::Object> fn, std::vector<std::shared_ptr<interp::object::Object>>& args)
+	// A loop's environment is made once and reused by every iteration, so a
+	// loop allocates nothing per iteration itself. When the body makes
+	// functions, which could keep the environment, each iteration gets its
+	// own instead. A loop is null unless a return or an error leaves it.
+	interp::object::Value eval_while(interp::ast::WhileExpression* loop, interp::object::Ref<interp::object::Environment>& env)
 	{
-		if (auto fn_obj = dynamic_cast<interp::object::FunctionObject*>(fn.get()))
+		interp::object::Ref<interp::object::Environment> loop_env;
+
+		while (true)
 		{
-			auto env = extend_fn_env(fn_obj, args);
-			return eval(fn_obj->body, env);
+			if (!loop_env || loop->captures)
+				loop_env = interp::object::Environment::new_env(env, loop->locals);
+
+			auto condition = eval(loop->condition, loop_env);
+			if (is_error(condition))
+				return condition;
+			if (!is_truthy(condition))
+				return NULL_OBJ;
+
+			auto result = eval_statments(loop->body->statements, loop_env);
+			if (result.type() == interp::object::ObjectType::ReturnObject || is_error(result))
+				return result;
 		}
-		else
+	}
+
+	interp::object::Value eval_for(interp::ast::ForExpression* loop, interp::object::Ref<interp::object::Environment>& env)
+	{
+		auto iterable = eval(loop->iterable, env);
+		if (is_error(iterable))
+			return iterable;
+		if (iterable.type() != interp::object::ObjectType::ArrayObject)
+			return not_iterable(iterable);
+
+		// Indexed rather than iterated, a push in the body may move the
+		// storage the array shares
+		auto array = iterable.as<interp::object::ArrayObject>();
+		interp::object::Ref<interp::object::Environment> loop_env;
+
+		for (size_t i = 0; i < array->length(); i++)
 		{
-			return new_error("not a function: " + interp::object::object_type_to_string(fn->type()));
+			if (!loop_env || loop->captures)
+				loop_env = interp::object::Environment::new_env(env, loop->locals);
+
+			loop_env->set(loop->variable.slot, array->elements()[i]);
+
+			auto result = eval_statments(loop->body->statements, loop_env);
+			if (result.type() == interp::object::ObjectType::ReturnObject || is_error(result))
+				return result;
+		}
+
+		return NULL_OBJ;
+	}
+
+	interp::object::Value not_iterable(const interp::object::Value& iterable)
+	{
+		return new_error("cannot iterate over " + interp::object::object_type_to_string(iterable.type()));
+	}
+
+	// Trampoline: a function ending in a tail call hands the call back here
+	// instead of making it, so it runs in this same native frame.
+	interp::object::Value apply_fn(const interp::object::Value& fn, std::vector<interp::object::Value>& args)
+	{
+		interp::object::Value callee = fn;
+		std::vector<interp::object::Value> tail_args;
+		auto* call_args = &args;
+
+		while (true)
+		{
+			if (callee.type() == interp::object::ObjectType::BuiltinFnObject)
+				return callee.as<interp::object::BuiltinFnObject>()->value(*call_args);
+
+			if (callee.type() != interp::object::ObjectType::FunctionObject)
+				return new_error("not a function: " + interp::object::object_type_to_string(callee.type()));
+
+			auto fn_obj = callee.as<interp::object::FunctionObject>();
+			auto env = extend_fn_env(fn_obj, *call_args);
+			auto result = eval(fn_obj->body, env);
+
+			// A return only leaves the function it is in
+			if (result.type() == interp::object::ObjectType::ReturnObject)
+				result = interp::object::Value(result.as<interp::object::ReturnObject>()->value);
+
+			if (result.type() != interp::object::ObjectType::TailCallObject)
+				return result;
+
+			auto call = result.as<interp::object::TailCallObject>();
+			tail_args = std::move(call->args);
+			call_args = &tail_args;
+			callee = std::move(call->function);
 		}
 	}
 
-	std::shared_ptr<interp::object::Environment> extend_fn_env(interp::object::FunctionObject* fn, std::vector<std::shared_ptr<interp::object::Object>>& args)
+	interp::object::Ref<interp::object::Environment> extend_fn_env(interp::object::FunctionObject* fn, std::vector<interp::object::Value>& args)
 	{
-		auto env = interp::object::Environment::new_env(fn->environment);
+		auto env = interp::object::Environment::new_env(fn->environment, fn->locals);
 
-		for (size_t i = 0; i < fn->params.size(); i++)
+		for (size_t i = 0; i < fn->params.size() && i < args.size(); i++)
 		{
-			env->set(fn->params[i]->value, args[i]);
+			env->set(fn->params[i]->slot, args[i]);
 		}
 
 		return env;
 	}
 
-	bool is_truthy(std::shared_ptr<interp::object::Object>& obj)
+	bool is_truthy(const interp::object::Value& obj)
 	{
-		switch (obj->type())
+		switch (obj.type())
 		{
 		case interp::object::ObjectType::BooleanObject:
-			return obj == TRUE;
+			return obj.as_boolean();
 		case interp::object::ObjectType::NullObject:
 			return false;
 		default:
@@ -371,13 +605,13 @@ namespace interp::eval
 		}
 	}
 
-	std::shared_ptr<interp::object::ErrorObject> new_error(std::string message)
+	interp::object::Value new_error(std::string message)
 	{
-		return std::shared_ptr<interp::object::ErrorObject>(new interp::object::ErrorObject(message));
+		return interp::object::nursery::make<interp::object::ErrorObject>(message);
 	}
 
-	bool is_error(std::shared_ptr<interp::object::Object>& obj)
+	bool is_error(const interp::object::Value& obj)
 	{
-		return obj->type() == interp::object::ObjectType::ErrorObject;
+		return obj.type() == interp::object::ObjectType::ErrorObject;
 	}
 }
\ No newline at end of file
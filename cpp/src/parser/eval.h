@@ -1,24 +1,29 @@
 #pragma once
 
+#include <span>
+
 #include "ast.h"
 #include "object.h"
 
 namespace interp::eval
 {
-	std::shared_ptr<interp::object::Object> eval(std::shared_ptr<interp::ast::Node> node, std::shared_ptr<interp::object::Environment>& env);
+	interp::object::Value eval(interp::ast::Node* node, interp::object::Ref<interp::object::Environment>& env);
 
-	std::shared_ptr<interp::object::Object> eval_statments(std::vector<std::shared_ptr<interp::ast::Statement>>& statements, std::shared_ptr<interp::object::Environment>& env, bool unwrap_return = false);
-	std::vector<std::shared_ptr<interp::object::Object>> eval_expressions(std::vector<std::shared_ptr<interp::ast::Expression>>& expressions, std::shared_ptr<interp::object::Environment>& env);
-	std::shared_ptr<interp::object::Object> eval_prefix(std::string& op, std::shared_ptr<interp::object::Object>& right);
-	std::shared_ptr<interp::object::Object> eval_bang(std::shared_ptr<interp::object::Object>& right);
-	std::shared_ptr<interp::object::Object> eval_minus(std::shared_ptr<interp::object::Object>& right);
-	std::shared_ptr<interp::object::Object> eval_infix(std::string& op, std::shared_ptr<interp::object::Object>& left, std::shared_ptr<interp::object::Object>& right);
-	std::shared_ptr<interp::object::Object> eval_int_infix(std::string& op, std::shared_ptr<interp::object::Object>& left, std::shared_ptr<interp::object::Object>& right);
-	std::shared_ptr<interp::object::Object> eval_string_infix(std::string& op, std::shared_ptr<interp::object::Object>& left, std::shared_ptr<interp::object::Object>& right);
-	std::shared_ptr<interp::object::Object> eval_if(interp::ast::IfExpression* ifExpr, std::shared_ptr<interp::object::Environment>& env);
-	std::shared_ptr<interp::object::Object> apply_fn(std::shared_ptr<interp::object::Object> fn, std::vector<std::shared_ptr<interp::object::Object>>& args);
-	std::shared_ptr<interp::object::Environment> extend_fn_env(interp::object::FunctionObject* fn, std::vector<std::shared_ptr<interp::object::Object>>& args);
-	bool is_truthy(std::shared_ptr<interp::object::Object>& obj);
-	std::shared_ptr<interp::object::ErrorObject> new_error(std::string message);
-	bool is_error(std::shared_ptr<interp::object::Object>& obj);
-}
\ No newline at end of file
+	interp::object::Value eval_statments(std::vector<interp::ast::Statement*>& statements, interp::object::Ref<interp::object::Environment>& env, bool unwrap_return = false);
+	std::vector<interp::object::Value> eval_expressions(std::vector<interp::ast::Expression*>& expressions, interp::object::Ref<interp::object::Environment>& env);
+	interp::object::Value eval_prefix(interp::ast::Operator op, const interp::object::Value& right);
+	interp::object::Value eval_bang(const interp::object::Value& right);
+	interp::object::Value eval_minus(const interp::object::Value& right);
+	interp::object::Value eval_infix(interp::ast::Operator op, const interp::object::Value& left, const interp::object::Value& right);
+	interp::object::Value eval_hash(std::span<const interp::object::Value> keys_and_values);
+	interp::object::Value eval_index(const interp::object::Value& left, const interp::object::Value& index);
+	interp::object::Value eval_if(interp::ast::IfExpression* ifExpr, interp::object::Ref<interp::object::Environment>& env);
+	interp::object::Value eval_while(interp::ast::WhileExpression* loop, interp::object::Ref<interp::object::Environment>& env);
+	interp::object::Value eval_for(interp::ast::ForExpression* loop, interp::object::Ref<interp::object::Environment>& env);
+	interp::object::Value not_iterable(const interp::object::Value& iterable);
+	interp::object::Value apply_fn(const interp::object::Value& fn, std::vector<interp::object::Value>& args);
+	interp::object::Ref<interp::object::Environment> extend_fn_env(interp::object::FunctionObject* fn, std::vector<interp::object::Value>& args);
+	bool is_truthy(const interp::object::Value& obj);
+	interp::object::Value new_error(std::string message);
+	bool is_error(const interp::object::Value& obj);
+}
@@ -0,0 +1,234 @@
+#include "folder.h"
+#include "eval.h"
+
+namespace interp::parser
+{
+	Folder::Folder(interp::ast::AstArena& arena)
+		: arena(arena)
+	{
+	}
+
+	void Folder::fold(interp::ast::Program* program)
+	{
+		for (auto statement : program->statements)
+		{
+			this->fold_statement(statement);
+		}
+	}
+
+	void Folder::fold_statement(interp::ast::Statement* statement)
+	{
+		switch (statement->type())
+		{
+		case interp::ast::NodeType::ExpressionStatment:
+		{
+			auto literal = static_cast<interp::ast::ExpressionStatement*>(statement);
+			literal->expression = this->fold_expression(literal->expression);
+			break;
+		}
+		case interp::ast::NodeType::LetStatment:
+		{
+			auto literal = static_cast<interp::ast::LetStatement*>(statement);
+			literal->value = this->fold_expression(literal->value);
+			break;
+		}
+		case interp::ast::NodeType::ReturnStatment:
+		{
+			auto literal = static_cast<interp::ast::ReturnStatement*>(statement);
+			literal->return_value = this->fold_expression(literal->return_value);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// Returns the node to use in place of expression, which may be itself
+	interp::ast::Expression* Folder::fold_expression(interp::ast::Expression* expression)
+	{
+		if (!expression)
+			return nullptr;
+
+		switch (expression->type())
+		{
+		case interp::ast::NodeType::ArrayLiteral:
+		{
+			auto literal = static_cast<interp::ast::ArrayLiteral*>(expression);
+			for (auto& element : literal->elements)
+			{
+				element = this->fold_expression(element);
+			}
+			return literal;
+		}
+		case interp::ast::NodeType::AssignExpression:
+		{
+			auto literal = static_cast<interp::ast::AssignExpression*>(expression);
+			literal->value = this->fold_expression(literal->value);
+			return literal;
+		}
+		case interp::ast::NodeType::BlockExpression:
+		{
+			auto literal = static_cast<interp::ast::BlockExpression*>(expression);
+			for (auto statement : literal->statements)
+			{
+				this->fold_statement(statement);
+			}
+			return literal;
+		}
+		case interp::ast::NodeType::CallExpression:
+		{
+			auto literal = static_cast<interp::ast::CallExpression*>(expression);
+			literal->function = this->fold_expression(literal->function);
+			for (auto& arg : literal->args)
+			{
+				arg = this->fold_expression(arg);
+			}
+			return literal;
+		}
+		case interp::ast::NodeType::ForExpression:
+		{
+			auto literal = static_cast<interp::ast::ForExpression*>(expression);
+			literal->iterable = this->fold_expression(literal->iterable);
+			this->fold_expression(literal->body);
+			return literal;
+		}
+		case interp::ast::NodeType::FunctionLiteral:
+		{
+			auto literal = static_cast<interp::ast::FunctionLiteral*>(expression);
+			literal->body = this->fold_expression(literal->body);
+			return literal;
+		}
+		case interp::ast::NodeType::HashLiteral:
+		{
+			auto literal = static_cast<interp::ast::HashLiteral*>(expression);
+			for (auto& [key, value] : literal->pairs)
+			{
+				key = this->fold_expression(key);
+				value = this->fold_expression(value);
+			}
+			return literal;
+		}
+		case interp::ast::NodeType::IfExpression:
+		{
+			auto literal = static_cast<interp::ast::IfExpression*>(expression);
+			literal->condition = this->fold_expression(literal->condition);
+			literal->consequence = this->fold_expression(literal->consequence);
+			literal->alternative = this->fold_expression(literal->alternative);
+
+			auto condition = this->constant(literal->condition);
+			if (!condition)
+				return literal;
+			if (interp::eval::is_truthy(condition))
+				return literal->consequence;
+			// Without an else the if is null, which has no literal
+			return literal->alternative ? literal->alternative : literal;
+		}
+		case interp::ast::NodeType::IndexExpression:
+		{
+			auto literal = static_cast<interp::ast::IndexExpression*>(expression);
+			literal->left = this->fold_expression(literal->left);
+			literal->index = this->fold_expression(literal->index);
+			return literal;
+		}
+		case interp::ast::NodeType::InfixExpression:
+		{
+			auto literal = static_cast<interp::ast::InfixExpression*>(expression);
+			literal->left = this->fold_expression(literal->left);
+			literal->right = this->fold_expression(literal->right);
+
+			auto left = this->constant(literal->left);
+			auto right = this->constant(literal->right);
+			if (!left || !right)
+				return literal;
+
+			auto folded = this->make_literal(interp::eval::eval_infix(literal->op, left, right));
+			return folded ? folded : literal;
+		}
+		case interp::ast::NodeType::PrefixExpression:
+		{
+			auto literal = static_cast<interp::ast::PrefixExpression*>(expression);
+			literal->right = this->fold_expression(literal->right);
+
+			auto right = this->constant(literal->right);
+			if (!right)
+				return literal;
+
+			auto folded = this->make_literal(interp::eval::eval_prefix(literal->op, right));
+			return folded ? folded : literal;
+		}
+		case interp::ast::NodeType::StringLiteral:
+		{
+			auto literal = static_cast<interp::ast::StringLiteral*>(expression);
+			if (!literal->cached)
+			{
+				literal->cached = interp::object::pool::make<interp::object::StringObject>(literal->value);
+			}
+			return literal;
+		}
+		case interp::ast::NodeType::WhileExpression:
+		{
+			// The body stays a block, the loop runs its statements itself
+			auto literal = static_cast<interp::ast::WhileExpression*>(expression);
+			literal->condition = this->fold_expression(literal->condition);
+			this->fold_expression(literal->body);
+			return literal;
+		}
+		default:
+			return expression;
+		}
+	}
+
+	// The value of a literal, or of a block holding just one, or an empty
+	// value for anything else
+	interp::object::Value Folder::constant(interp::ast::Expression* expression)
+	{
+		if (!expression)
+			return interp::object::Value();
+
+		switch (expression->type())
+		{
+		case interp::ast::NodeType::BlockExpression:
+		{
+			auto literal = static_cast<interp::ast::BlockExpression*>(expression);
+			if (literal->statements.size() != 1 || literal->statements[0]->type() != interp::ast::NodeType::ExpressionStatment)
+				return interp::object::Value();
+			return this->constant(static_cast<interp::ast::ExpressionStatement*>(literal->statements[0])->expression);
+		}
+		case interp::ast::NodeType::IntegerLiteral:
+			return interp::object::Value::integer(static_cast<interp::ast::IntegerLiteral*>(expression)->value);
+		case interp::ast::NodeType::BooleanExpression:
+			return interp::object::Value::boolean(static_cast<interp::ast::BooleanLiteral*>(expression)->value);
+		case interp::ast::NodeType::StringLiteral:
+			return static_cast<interp::ast::StringLiteral*>(expression)->cached;
+		default:
+			return interp::object::Value();
+		}
+	}
+
+	// A literal node for value, or nullptr if it has none (errors, null)
+	interp::ast::Expression* Folder::make_literal(const interp::object::Value& value)
+	{
+		switch (value.type())
+		{
+		case interp::object::ObjectType::IntegerObject:
+			return this->arena.make<interp::ast::IntegerLiteral>(
+				interp::token::Token{ interp::token::INT, std::to_string(value.as_integer()) }, value.as_integer());
+		case interp::object::ObjectType::BooleanObject:
+		{
+			auto type = value.as_boolean() ? interp::token::TRUE : interp::token::FALSE;
+			return this->arena.make<interp::ast::BooleanLiteral>(
+				interp::token::Token{ type, value.as_boolean() ? "true" : "false" }, value.as_boolean());
+		}
+		case interp::object::ObjectType::StringObject:
+		{
+			// Remade outside the nursery, it lives as long as the program
+			auto str = value.as<interp::object::StringObject>()->value();
+			auto literal = this->arena.make<interp::ast::StringLiteral>(interp::token::Token{ interp::token::STRING, str }, str);
+			literal->cached = interp::object::pool::make<interp::object::StringObject>(str);
+			return literal;
+		}
+		default:
+			return nullptr;
+		}
+	}
+}
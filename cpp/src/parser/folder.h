@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ast.h"
+#include "object/value.h"
+
+namespace interp::parser
+{
+	// Rewrites a program before it runs: prefix and infix expressions whose
+	// operands are literals become the literal they evaluate to, ifs with a
+	// literal condition become the branch they take, and every string literal
+	// gets the object its evaluations share. Operators are applied with the
+	// evaluator's own implementation and anything that would produce an
+	// error (like division by zero) is left for run time.
+	class Folder
+	{
+	public:
+		// Replacement nodes are allocated in arena
+		Folder(interp::ast::AstArena& arena);
+		~Folder() = default;
+
+		void fold(interp::ast::Program* program);
+
+	private:
+		interp::ast::AstArena& arena;
+
+		void fold_statement(interp::ast::Statement* statement);
+		interp::ast::Expression* fold_expression(interp::ast::Expression* expression);
+		interp::object::Value constant(interp::ast::Expression* expression);
+		interp::ast::Expression* make_literal(const interp::object::Value& value);
+	};
+}
@@ -1,12 +1,17 @@
 #pragma once
 
+#include "object/array_obj.h"
 #include "object/base_obj.h"
-#include "object/bool_obj.h"
 #include "object/builtin_fn.h"
+#include "object/collector.h"
 #include "object/environment.h"
 #include "object/error_obj.h"
 #include "object/func_obj.h"
-#include "object/int_obj.h"
-#include "object/null_obj.h"
+#include "object/hash_obj.h"
+#include "object/nursery.h"
+#include "object/pool.h"
+#include "object/ref.h"
 #include "object/return_obj.h"
-#include "object/string_obj.h"
\ No newline at end of file
+#include "object/string_obj.h"
+#include "object/tail_call_obj.h"
+#include "object/value.h"
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "array_obj.h"
+#include "pool.h"
+
+namespace interp::object
+{
+	ArrayObject::ArrayObject(std::vector<Value> elements)
+		: storage(std::move(elements)), offset(0)
+	{
+		this->count = this->storage.size();
+		for (auto& value : this->storage)
+		{
+			this->traced = this->traced || gc::is_traced(value);
+		}
+	}
+
+	ArrayObject::ArrayObject(Ref<ArrayObject> owner, size_t offset, size_t count)
+		: owner(std::move(owner)), offset(offset), count(count)
+	{
+	}
+
+	Ref<ArrayObject> ArrayObject::slice(Ref<ArrayObject> array, size_t offset, size_t count)
+	{
+		auto owner = array->owner ? array->owner : array;
+		return pool::make<ArrayObject>(std::move(owner), array->offset + offset, count);
+	}
+
+	Ref<ArrayObject> ArrayObject::push(Ref<ArrayObject> array, Value value)
+	{
+		auto& owner = array->owner ? *array->owner : *array;
+		if (array->offset + array->count == owner.storage.size())
+		{
+			owner.traced = owner.traced || gc::is_traced(value);
+			owner.storage.push_back(std::move(value));
+			auto count = array->count + 1;
+			return ArrayObject::slice(std::move(array), 0, count);
+		}
+
+		// Another array already extended the store past this one
+		auto elements = array->elements();
+		std::vector<Value> copy;
+		copy.reserve(elements.size() + 1);
+		copy.assign(elements.begin(), elements.end());
+		copy.push_back(std::move(value));
+		return pool::make<ArrayObject>(std::move(copy));
+	}
+
+	ObjectType ArrayObject::type() const
+	{
+		return ObjectType::ArrayObject;
+	}
+
+	std::string ArrayObject::inspect() const
+	{
+		std::string out = "[";
+
+		auto elements = this->elements();
+		for (size_t i = 0; i < elements.size(); i++)
+		{
+			out += elements[i].inspect();
+			if (i < elements.size() - 1)
+			{
+				out += ", ";
+			}
+		}
+
+		out += "]";
+
+		return out;
+	}
+
+	void ArrayObject::trace(Visitor visit) const
+	{
+		if (this->owner)
+		{
+			visit(this->owner.get());
+		}
+		if (this->traced)
+		{
+			for (auto& value : this->storage)
+			{
+				gc::trace_value(value, visit);
+			}
+		}
+	}
+
+	void ArrayObject::clear_references()
+	{
+		this->owner.reset();
+		this->storage.clear();
+		this->traced = false;
+		this->offset = 0;
+		this->count = 0;
+	}
+
+	long ArrayObject::strong_count() const
+	{
+		return this->ref_count();
+	}
+
+	Ref<const RefCounted> ArrayObject::keep_alive() const
+	{
+		return Ref<const RefCounted>(this);
+	}
+}
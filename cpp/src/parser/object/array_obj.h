@@ -0,0 +1,63 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "base_obj.h"
+#include "collector.h"
+#include "value.h"
+
+namespace interp::object
+{
+	// An immutable array. Its elements are a range of a contiguous store
+	// that arrays made from it share: a slice is a view of part of the store,
+	// and pushing onto an array that ends where the store does appends to the
+	// store in place, so building an array one push at a time costs amortized
+	// O(1) per element. What lies past an array's end is never visible to it.
+	class ArrayObject : public Object, public gc::Traceable
+	{
+	public:
+		ArrayObject(std::vector<Value> elements);
+		// A view of count elements of owner's store, from offset
+		ArrayObject(Ref<ArrayObject> owner, size_t offset, size_t count);
+		~ArrayObject() = default;
+
+		static Ref<ArrayObject> slice(Ref<ArrayObject> array, size_t offset, size_t count);
+		// array with value appended
+		static Ref<ArrayObject> push(Ref<ArrayObject> array, Value value);
+
+		std::span<const Value> elements() const
+		{
+			return std::span<const Value>(this->store().data() + this->offset, this->count);
+		}
+
+		size_t length() const
+		{
+			return this->count;
+		}
+
+		ObjectType type() const override;
+		std::string inspect() const override;
+
+		void trace(Visitor visit) const override;
+		void clear_references() override;
+		long strong_count() const override;
+		Ref<const RefCounted> keep_alive() const override;
+
+	private:
+		// Set when the store belongs to another array
+		Ref<ArrayObject> owner;
+		// Grows under the arrays sharing it, see push
+		mutable std::vector<Value> storage;
+		// Whether storage holds anything the collector tracks, so stores of
+		// plain values are not walked on every collection
+		bool traced = false;
+		size_t offset;
+		size_t count;
+
+		std::vector<Value>& store() const
+		{
+			return this->owner ? this->owner->storage : this->storage;
+		}
+	};
+}
\ No newline at end of file
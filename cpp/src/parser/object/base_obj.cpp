@@ -22,6 +22,12 @@ namespace interp::object
 			return "STRING";
 		case interp::object::ObjectType::BuiltinFnObject:
 			return "BuiltinFnObject";
+		case interp::object::ObjectType::TailCallObject:
+			return "TailCallObject";
+		case interp::object::ObjectType::ArrayObject:
+			return "ARRAY";
+		case interp::object::ObjectType::HashObject:
+			return "HASH";
 		default:
 			return "Unknown Type";
 		}
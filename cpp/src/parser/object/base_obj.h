@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 
+#include "ref.h"
+
 namespace interp::object
 {
-	enum struct ObjectType
+	// Integers, booleans and null are stored inline in a Value and have no
+	// Object class, keep them first.
+	enum struct ObjectType : uint8_t
 	{
 		IntegerObject,
 		BooleanObject,
@@ -14,11 +19,18 @@ namespace interp::object
 		FunctionObject,
 		StringObject,
 		BuiltinFnObject,
+		TailCallObject,
+		ArrayObject,
+		HashObject,
+
+		Count, // Number of object types, keep last
 	};
 
+	constexpr size_t OBJECT_TYPE_COUNT = static_cast<size_t>(ObjectType::Count);
+
 	std::string object_type_to_string(ObjectType object_type);
 
-	class Object
+	class Object : public RefCounted
 	{
 	public:
 		virtual ~Object() = default;
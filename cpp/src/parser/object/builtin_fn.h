@@ -1,12 +1,14 @@
 #pragma once
 
-#include <vector>
+#include <span>
 
 #include "base_obj.h"
+#include "value.h"
 
 namespace interp::object
 {
-	typedef std::shared_ptr<Object>(*BuiltinFn)(std::vector<std::shared_ptr<Object>>);
+	// Arguments are a view of the caller's values, valid for the call only
+	typedef Value(*BuiltinFn)(std::span<const Value> args);
 
 	class BuiltinFnObject : public Object
 	{
@@ -0,0 +1,197 @@
+#include <vector>
+
+#include "array_obj.h"
+#include "collector.h"
+#include "func_obj.h"
+#include "hash_obj.h"
+
+namespace interp::object::gc
+{
+	struct Registry
+	{
+		Traceable* head = nullptr;
+		size_t tracked = 0;
+		size_t allocated = 0;
+		size_t threshold = MIN_THRESHOLD;
+		size_t collections = 0;
+		size_t collected = 0;
+
+		static Registry& get()
+		{
+			thread_local Registry registry;
+			return registry;
+		}
+
+		static void link(Traceable* obj)
+		{
+			auto& registry = Registry::get();
+			obj->prev = nullptr;
+			obj->next = registry.head;
+			if (registry.head)
+			{
+				registry.head->prev = obj;
+			}
+			registry.head = obj;
+			registry.tracked++;
+			registry.allocated++;
+		}
+
+		static void unlink(Traceable* obj)
+		{
+			auto& registry = Registry::get();
+			if (obj->prev)
+			{
+				obj->prev->next = obj->next;
+			}
+			else
+			{
+				registry.head = obj->next;
+			}
+			if (obj->next)
+			{
+				obj->next->prev = obj->prev;
+			}
+			registry.tracked--;
+		}
+
+		// gc_refs doubles as the mark: after the internal references are
+		// subtracted, anything above zero is a root and REACHABLE marks
+		// objects found from one.
+		static constexpr intptr_t REACHABLE = -1;
+
+		static void drop_internal(Traceable* obj)
+		{
+			if (obj->gc_refs > 0)
+			{
+				obj->gc_refs--;
+			}
+		}
+
+		static std::vector<Traceable*>& pending()
+		{
+			thread_local std::vector<Traceable*> pending;
+			return pending;
+		}
+
+		static void mark(Traceable* obj)
+		{
+			if (obj->gc_refs != REACHABLE)
+			{
+				obj->gc_refs = REACHABLE;
+				Registry::pending().push_back(obj);
+			}
+		}
+
+		size_t collect()
+		{
+			for (auto obj = this->head; obj; obj = obj->next)
+			{
+				auto count = obj->strong_count();
+				// Objects still being built are not owned yet, treat them as roots
+				obj->gc_refs = count > 0 ? count : 1;
+			}
+			for (auto obj = this->head; obj; obj = obj->next)
+			{
+				obj->trace(Registry::drop_internal);
+			}
+
+			auto& pending = Registry::pending();
+			for (auto obj = this->head; obj; obj = obj->next)
+			{
+				if (obj->gc_refs > 0)
+				{
+					Registry::mark(obj);
+				}
+			}
+			while (!pending.empty())
+			{
+				auto obj = pending.back();
+				pending.pop_back();
+				obj->trace(Registry::mark);
+			}
+
+			std::vector<Ref<const RefCounted>> garbage;
+			std::vector<Traceable*> cleared;
+			for (auto obj = this->head; obj; obj = obj->next)
+			{
+				if (obj->gc_refs != REACHABLE)
+				{
+					garbage.push_back(obj->keep_alive());
+					cleared.push_back(obj);
+				}
+			}
+			for (auto obj : cleared)
+			{
+				obj->clear_references();
+			}
+
+			this->collections++;
+			this->collected += cleared.size();
+			this->allocated = 0;
+			auto survivors = this->tracked - cleared.size();
+			this->threshold = survivors > MIN_THRESHOLD ? survivors : MIN_THRESHOLD;
+			return cleared.size();
+		}
+	};
+
+	Traceable::Traceable()
+	{
+		Registry::link(this);
+	}
+
+	Traceable::~Traceable()
+	{
+		Registry::unlink(this);
+	}
+
+	bool is_traced(const Value& value)
+	{
+		switch (value.type())
+		{
+		case ObjectType::FunctionObject:
+		case ObjectType::ArrayObject:
+		case ObjectType::HashObject:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void trace_value(const Value& value, Traceable::Visitor visit)
+	{
+		switch (value.type())
+		{
+		case ObjectType::FunctionObject:
+			visit(value.as<FunctionObject>());
+			break;
+		case ObjectType::ArrayObject:
+			visit(value.as<ArrayObject>());
+			break;
+		case ObjectType::HashObject:
+			visit(value.as<HashObject>());
+			break;
+		default:
+			break;
+		}
+	}
+
+	size_t collect()
+	{
+		return Registry::get().collect();
+	}
+
+	void maybe_collect()
+	{
+		auto& registry = Registry::get();
+		if (registry.allocated >= registry.threshold)
+		{
+			registry.collect();
+		}
+	}
+
+	Stats stats()
+	{
+		auto& registry = Registry::get();
+		return Stats{registry.tracked, registry.collections, registry.collected};
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "value.h"
+
+namespace interp::object::gc
+{
+	// Base of every object that can hold a strong reference to another one and
+	// so take part in a reference cycle (environments, closures, arrays and
+	// hashes). Tracked objects are kept in a per-thread list that the
+	// collector walks.
+	class Traceable
+	{
+	public:
+		Traceable();
+		virtual ~Traceable();
+
+		Traceable(const Traceable&) = delete;
+		Traceable& operator=(const Traceable&) = delete;
+
+		typedef void (*Visitor)(Traceable*);
+
+		// Calls visit once for every tracked object this one references
+		virtual void trace(Visitor visit) const = 0;
+		// Drops every reference this object holds, breaking the cycles it is in
+		virtual void clear_references() = 0;
+		// Number of Refs owning this object, 0 while it is not owned yet
+		virtual long strong_count() const = 0;
+		// Owning pointer used to keep the object alive while cycles are broken
+		virtual Ref<const RefCounted> keep_alive() const = 0;
+
+	private:
+		friend struct Registry;
+
+		Traceable* prev;
+		Traceable* next;
+		intptr_t gc_refs;
+	};
+
+	// Whether value holds a tracked object
+	bool is_traced(const Value& value);
+	// Visits the tracked object held by value, if any
+	void trace_value(const Value& value, Traceable::Visitor visit);
+
+	struct Stats
+	{
+		size_t tracked;
+		size_t collections;
+		size_t collected;
+	};
+
+	// Allocations of tracked objects between two automatic collections, the
+	// threshold grows with the number of survivors so collection stays linear.
+	constexpr size_t MIN_THRESHOLD = 10000;
+
+	// Frees every tracked object only reachable through reference cycles and
+	// returns how many were found. Everything owned from outside the tracked
+	// set (environments held by an evaluator, values on a VM stack, ...) is a
+	// root, so this is safe to call wherever no tracked object is referenced
+	// by a raw pointer alone.
+	size_t collect();
+	// Collects once enough tracked objects were allocated since the last run
+	void maybe_collect();
+	Stats stats();
+}
@@ -1,35 +1,96 @@
 #include "environment.h"
+#include "pool.h"
 
 namespace interp::object
 {
-	Environment::Environment(std::shared_ptr<Environment> outer)
-		: outer(outer)
+	Environment::Environment(Ref<Environment> outer, size_t size)
+		: outer(outer), slots(size)
 	{
 	}
 
-	std::shared_ptr<Object> Environment::get(const std::string& ident)
+	const Value& Environment::get(uint32_t depth, uint32_t slot)
 	{
-		if (this->store.find(ident) == this->store.end())
+		Environment* env = this;
+		for (; depth > 0; depth--)
 		{
-			if (this->outer)
-				return this->outer->get(ident);
+			env = env->outer.get();
+		}
+
+		return env->slots[slot];
+	}
+
+	const Value& Environment::set(uint32_t slot, Value obj)
+	{
+		this->slots[slot] = std::move(obj);
+		return this->slots[slot];
+	}
 
-			return nullptr;
+	const Value& Environment::assign(uint32_t depth, uint32_t slot, Value obj)
+	{
+		Environment* env = this;
+		for (; depth > 0; depth--)
+		{
+			env = env->outer.get();
 		}
-		else
+
+		auto& current = env->slots[slot];
+		if (current)
+			current = std::move(obj);
+		return current;
+	}
+
+	uint32_t Environment::declare(interp::lexer::Atom name)
+	{
+		this->slot_names.push_back(name);
+		this->slots.emplace_back();
+		return static_cast<uint32_t>(this->slots.size() - 1);
+	}
+
+	const std::vector<interp::lexer::Atom>& Environment::names() const
+	{
+		return this->slot_names;
+	}
+
+	const Ref<Environment>& Environment::enclosing() const
+	{
+		return this->outer;
+	}
+
+	Ref<Environment> Environment::new_env(Ref<Environment> outer, size_t size)
+	{
+		gc::maybe_collect();
+		return pool::make<Environment>(outer, size);
+	}
+
+	void Environment::trace(Visitor visit) const
+	{
+		if (this->outer)
+		{
+			visit(this->outer.get());
+		}
+		for (auto& value : this->slots)
+		{
+			gc::trace_value(value, visit);
+		}
+	}
+
+	void Environment::clear_references()
+	{
+		// Keep the slot count, get and set stay in bounds
+		for (auto& value : this->slots)
 		{
-			return this->store[ident];
+			value = Value();
 		}
+		this->outer.reset();
 	}
 
-	std::shared_ptr<Object> Environment::set(const std::string& ident, std::shared_ptr<Object> obj)
+	long Environment::strong_count() const
 	{
-		this->store[ident] = obj;
-		return obj;
+		return this->ref_count();
 	}
 
-	std::shared_ptr<Environment> Environment::new_env(std::shared_ptr<Environment> outer)
+	Ref<const RefCounted> Environment::keep_alive() const
 	{
-		return std::shared_ptr<Environment>(new Environment(outer));
+		return Ref<const RefCounted>(this);
 	}
-}
\ No newline at end of file
+}
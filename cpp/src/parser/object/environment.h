@@ -1,26 +1,48 @@
 #pragma once
 
 #include <iostream>
-#include <map>
-#include <memory>
+#include <string>
+#include <vector>
 
 #include "base_obj.h"
+#include "lexer/atom.h"
+#include "collector.h"
+#include "value.h"
 
 namespace interp::object
 {
-	class Environment
+	class Environment : public RefCounted, public gc::Traceable
 	{
 	public:
-		Environment(std::shared_ptr<Environment> outer);
+		Environment(Ref<Environment> outer, size_t size);
 		~Environment() = default;
 
-		std::shared_ptr<Object> get(const std::string&);
-		std::shared_ptr<Object> set(const std::string&, std::shared_ptr<Object>);
+		// Variables are addressed by the (depth, slot) pair the resolver gave
+		// their identifier. Unassigned slots hold an empty Value.
+		const Value& get(uint32_t depth, uint32_t slot);
+		const Value& set(uint32_t slot, Value);
+		// Stores into a variable that is already set, returning the empty
+		// Value and leaving it alone if it is not.
+		const Value& assign(uint32_t depth, uint32_t slot, Value);
 
-		static std::shared_ptr<Environment> new_env(std::shared_ptr<Environment> outer);
+		// Adds a named slot, used for the global environment so that programs
+		// run against it later (like REPL lines) resolve to the same slots.
+		uint32_t declare(interp::lexer::Atom name);
+		const std::vector<interp::lexer::Atom>& names() const;
+		const Ref<Environment>& enclosing() const;
+
+		// May run a collection first, so every tracked object in use must be
+		// owned through a Ref or Value when this is called.
+		static Ref<Environment> new_env(Ref<Environment> outer, size_t size = 0);
+
+		void trace(Visitor visit) const override;
+		void clear_references() override;
+		long strong_count() const override;
+		Ref<const RefCounted> keep_alive() const override;
 
 	private:
-		std::shared_ptr<Environment> outer;
-		std::map<std::string, std::shared_ptr<Object>> store;
+		Ref<Environment> outer;
+		std::vector<Value> slots;
+		std::vector<interp::lexer::Atom> slot_names;
 	};
-}
\ No newline at end of file
+}
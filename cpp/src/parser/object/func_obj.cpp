@@ -2,11 +2,14 @@
 
 namespace interp::object
 {
-	FunctionObject::FunctionObject(interp::ast::FunctionLiteral* fn_lit, std::shared_ptr<Environment> environment)
+	FunctionObject::FunctionObject(interp::ast::FunctionLiteral* fn_lit, Ref<Environment> environment, std::shared_ptr<const interp::compiler::FunctionProto> proto)
 	{
 		this->params = fn_lit->params;
 		this->body = fn_lit->body;
+		this->locals = fn_lit->locals;
+		this->arena = fn_lit->arena ? fn_lit->arena->shared_from_this() : nullptr;
 		this->environment = environment;
+		this->proto = proto;
 	}
 
 	ObjectType FunctionObject::type() const
@@ -36,4 +39,28 @@ namespace interp::object
 
 		return out;
 	}
-}
\ No newline at end of file
+
+	void FunctionObject::trace(Visitor visit) const
+	{
+		if (this->environment)
+		{
+			visit(this->environment.get());
+		}
+	}
+
+	// The body and arena stay, only the environment can lead back here
+	void FunctionObject::clear_references()
+	{
+		this->environment.reset();
+	}
+
+	long FunctionObject::strong_count() const
+	{
+		return this->ref_count();
+	}
+
+	Ref<const RefCounted> FunctionObject::keep_alive() const
+	{
+		return Ref<const RefCounted>(this);
+	}
+}
@@ -6,19 +6,34 @@
 #include "base_obj.h"
 #include "environment.h"
 
+namespace interp::compiler
+{
+	struct FunctionProto;
+}
+
 namespace interp::object
 {
-	class FunctionObject : public Object
+	class FunctionObject : public Object, public gc::Traceable
 	{
 	public:
-		FunctionObject(interp::ast::FunctionLiteral*, std::shared_ptr<Environment>);
+		FunctionObject(interp::ast::FunctionLiteral*, Ref<Environment>, std::shared_ptr<const interp::compiler::FunctionProto> proto = nullptr);
 		~FunctionObject() = default;
 
-		std::vector<std::shared_ptr<interp::ast::Identifier>> params;
-		std::shared_ptr<interp::ast::Expression> body;
-		std::shared_ptr<Environment> environment;
+		std::vector<interp::ast::Identifier*> params;
+		interp::ast::Expression* body;
+		uint32_t locals;
+		// Keeps the nodes of params and body alive
+		std::shared_ptr<interp::ast::AstArena> arena;
+		Ref<Environment> environment;
+		// Bytecode of the body when the function was made by the VM
+		std::shared_ptr<const interp::compiler::FunctionProto> proto;
 
 		ObjectType type() const override;
 		std::string inspect() const override;
+
+		void trace(Visitor visit) const override;
+		void clear_references() override;
+		long strong_count() const override;
+		Ref<const RefCounted> keep_alive() const override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include <bit>
+#include <cstring>
+
+#include "hash_obj.h"
+#include "string_obj.h"
+
+namespace interp::object
+{
+	// Control byte of a slot without a key. Full slots hold the low 7 bits of
+	// their key's hash, so only empty ones have the high bit set.
+	constexpr uint8_t EMPTY = 0x80;
+
+	constexpr uint64_t LOW_BITS = 0x0101010101010101;
+	constexpr uint64_t HIGH_BITS = 0x8080808080808080;
+
+	// The high bit of every byte of group equal to byte is set in the result,
+	// along with, rarely, that of a byte next to a match. Callers compare keys.
+	inline uint64_t match_byte(uint64_t group, uint8_t byte)
+	{
+		auto x = group ^ (LOW_BITS * byte);
+		return (x - LOW_BITS) & ~x & HIGH_BITS;
+	}
+
+	// Byte i of the group is bits 8i to 8i + 7 in either byte order
+	inline uint64_t load_group(const uint8_t* control)
+	{
+		uint64_t group = 0;
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			std::memcpy(&group, control, sizeof(group));
+		}
+		else
+		{
+			for (size_t i = 0; i < sizeof(group); i++)
+			{
+				group |= static_cast<uint64_t>(control[i]) << (8 * i);
+			}
+		}
+		return group;
+	}
+
+	// Index within its group of the byte whose high bit is the lowest set in bits
+	inline size_t first_byte(uint64_t bits)
+	{
+		return std::countr_zero(bits) / 8;
+	}
+
+	// Spreads every input bit over the whole result (splitmix64's finalizer)
+	inline uint64_t mix(uint64_t x)
+	{
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+		return x ^ (x >> 31);
+	}
+
+	bool is_hashable(const Value& key)
+	{
+		switch (key.type())
+		{
+		case ObjectType::IntegerObject:
+		case ObjectType::BooleanObject:
+		case ObjectType::StringObject:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	uint64_t hash_key(const Value& key)
+	{
+		switch (key.type())
+		{
+		case ObjectType::IntegerObject:
+			return mix(static_cast<uint64_t>(key.as_integer()));
+		case ObjectType::BooleanObject:
+			return mix(key.as_boolean() ? 0x9e3779b97f4a7c15 : 0x7f4a7c159e3779b9);
+		default:
+			return mix(key.as<StringObject>()->hash());
+		}
+	}
+
+	bool keys_equal(const Value& left, const Value& right)
+	{
+		if (left.type() != right.type())
+			return false;
+
+		switch (left.type())
+		{
+		case ObjectType::IntegerObject:
+			return left.as_integer() == right.as_integer();
+		case ObjectType::BooleanObject:
+			return left.as_boolean() == right.as_boolean();
+		case ObjectType::StringObject:
+		{
+			auto left_str = left.as<StringObject>();
+			auto right_str = right.as<StringObject>();
+			return left_str == right_str
+				|| (left_str->length() == right_str->length()
+					&& left_str->hash() == right_str->hash()
+					&& left_str->value() == right_str->value());
+		}
+		default:
+			return false;
+		}
+	}
+
+	HashObject::HashObject(std::span<const Value> keys_and_values)
+	{
+		// At most 7 of every 8 slots are full, so every probe ends
+		size_t pairs = keys_and_values.size() / 2;
+		size_t groups = std::bit_ceil((pairs * 8 / 7 + GROUP_SIZE) / GROUP_SIZE);
+		this->control.assign(groups * GROUP_SIZE, EMPTY);
+		this->slots.resize(groups * GROUP_SIZE);
+
+		for (size_t i = 0; i + 1 < keys_and_values.size(); i += 2)
+		{
+			this->insert(keys_and_values[i], keys_and_values[i + 1]);
+		}
+	}
+
+	// Probes groups in triangular steps from the one the hash picks, which
+	// visits every group once the number of groups is a power of two.
+	const Value* HashObject::get(const Value& key) const
+	{
+		auto hash = hash_key(key);
+		auto tag = static_cast<uint8_t>(hash & 0x7f);
+		size_t mask = this->control.size() / GROUP_SIZE - 1;
+		size_t group_index = (hash >> 7) & mask;
+
+		for (size_t step = 1; ; step++)
+		{
+			auto offset = group_index * GROUP_SIZE;
+			auto group = load_group(this->control.data() + offset);
+			for (auto bits = match_byte(group, tag); bits; bits &= bits - 1)
+			{
+				auto& slot = this->slots[offset + first_byte(bits)];
+				if (keys_equal(slot.key, key))
+					return &slot.value;
+			}
+			// The key would have been put in the first empty slot
+			if (group & HIGH_BITS)
+				return nullptr;
+			group_index = (group_index + step) & mask;
+		}
+	}
+
+	size_t HashObject::length() const
+	{
+		return this->count;
+	}
+
+	void HashObject::insert(const Value& key, const Value& value)
+	{
+		auto hash = hash_key(key);
+		auto tag = static_cast<uint8_t>(hash & 0x7f);
+		size_t mask = this->control.size() / GROUP_SIZE - 1;
+		size_t group_index = (hash >> 7) & mask;
+
+		this->traced = this->traced || gc::is_traced(value);
+
+		for (size_t step = 1; ; step++)
+		{
+			auto offset = group_index * GROUP_SIZE;
+			auto group = load_group(this->control.data() + offset);
+			for (auto bits = match_byte(group, tag); bits; bits &= bits - 1)
+			{
+				auto& slot = this->slots[offset + first_byte(bits)];
+				if (keys_equal(slot.key, key))
+				{
+					slot.value = value;
+					return;
+				}
+			}
+			if (auto empty = group & HIGH_BITS)
+			{
+				auto index = offset + first_byte(empty);
+				this->control[index] = tag;
+				this->slots[index] = Slot{ key, value };
+				this->count++;
+				return;
+			}
+			group_index = (group_index + step) & mask;
+		}
+	}
+
+	ObjectType HashObject::type() const
+	{
+		return ObjectType::HashObject;
+	}
+
+	std::string HashObject::inspect() const
+	{
+		std::string out = "{";
+
+		size_t printed = 0;
+		for (size_t i = 0; i < this->slots.size(); i++)
+		{
+			if (this->control[i] == EMPTY)
+				continue;
+
+			out += this->slots[i].key.inspect() + ": " + this->slots[i].value.inspect();
+			if (++printed < this->count)
+			{
+				out += ", ";
+			}
+		}
+
+		out += "}";
+
+		return out;
+	}
+
+	void HashObject::trace(Visitor visit) const
+	{
+		if (this->traced)
+		{
+			for (auto& slot : this->slots)
+			{
+				gc::trace_value(slot.value, visit);
+			}
+		}
+	}
+
+	void HashObject::clear_references()
+	{
+		this->control.assign(GROUP_SIZE, EMPTY);
+		this->slots.assign(GROUP_SIZE, Slot{});
+		this->count = 0;
+		this->traced = false;
+	}
+
+	long HashObject::strong_count() const
+	{
+		return this->ref_count();
+	}
+
+	Ref<const RefCounted> HashObject::keep_alive() const
+	{
+		return Ref<const RefCounted>(this);
+	}
+}
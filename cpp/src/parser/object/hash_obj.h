@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "base_obj.h"
+#include "collector.h"
+#include "value.h"
+
+namespace interp::object
+{
+	// Integers, booleans and strings can be hash keys. Strings compare by
+	// contents and keep their hash, integers and booleans are inline and
+	// hashed by a few arithmetic instructions instead.
+	bool is_hashable(const Value& key);
+	// key must be hashable
+	uint64_t hash_key(const Value& key);
+	bool keys_equal(const Value& left, const Value& right);
+
+	// An immutable hash table with open addressing, laid out like a Swiss
+	// table: every slot has a control byte holding 7 bits of its key's hash,
+	// or marking it empty, and probes test a group of 8 control bytes at
+	// once. Most lookups read one group and compare one key.
+	class HashObject : public Object, public gc::Traceable
+	{
+	public:
+		// Keys each followed by their value, all keys hashable. A key given
+		// twice keeps its last value.
+		HashObject(std::span<const Value> keys_and_values);
+		~HashObject() = default;
+
+		// The value under key, nullptr if there is none. key must be hashable
+		const Value* get(const Value& key) const;
+		size_t length() const;
+
+		ObjectType type() const override;
+		std::string inspect() const override;
+
+		void trace(Visitor visit) const override;
+		void clear_references() override;
+		long strong_count() const override;
+		Ref<const RefCounted> keep_alive() const override;
+
+	private:
+		static constexpr size_t GROUP_SIZE = 8;
+
+		struct Slot
+		{
+			Value key;
+			Value value;
+		};
+
+		// One byte per slot, a multiple of GROUP_SIZE long
+		std::vector<uint8_t> control;
+		std::vector<Slot> slots;
+		size_t count = 0;
+		// Whether a value is anything the collector tracks
+		bool traced = false;
+
+		void insert(const Value& key, const Value& value);
+	};
+}
\ No newline at end of file
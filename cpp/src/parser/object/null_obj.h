@@ -1,16 +0,0 @@
-#pragma once
-
-#include "base_obj.h"
-
-namespace interp::object
-{
-	class Null : public Object
-	{
-	public:
-		Null() = default;
-		~Null() = default;
-
-		ObjectType type() const override;
-		std::string inspect() const override;
-	};
-}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#include "nursery.h"
+
+namespace interp::object::nursery
+{
+	constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+	constexpr size_t align_up(size_t bytes)
+	{
+		return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	struct alignas(std::max_align_t) Chunk
+	{
+		size_t capacity;
+		size_t top;
+		size_t live;
+		// Promoted chunks are freed by the release of their last object
+		bool promoted;
+
+		char* data()
+		{
+			return reinterpret_cast<char*>(this) + align_up(sizeof(Chunk));
+		}
+	};
+
+	// Every allocation is preceded by the chunk it came from, null for the
+	// ones made with operator new
+	struct alignas(std::max_align_t) Header
+	{
+		Chunk* chunk;
+	};
+
+	Chunk* new_chunk(size_t capacity)
+	{
+		auto chunk = static_cast<Chunk*>(::operator new(align_up(sizeof(Chunk)) + capacity));
+		chunk->capacity = capacity;
+		chunk->top = 0;
+		chunk->live = 0;
+		chunk->promoted = false;
+		return chunk;
+	}
+
+	struct Nursery
+	{
+		Chunk* current = nullptr;
+		size_t chunk_size = DEFAULT_SIZE;
+		Stats stats = {};
+
+		~Nursery()
+		{
+			if (this->current)
+			{
+				this->promote(this->current);
+			}
+		}
+
+		static Nursery& get()
+		{
+			thread_local Nursery nursery;
+			return nursery;
+		}
+
+		void promote(Chunk* chunk)
+		{
+			if (chunk->live == 0)
+			{
+				::operator delete(chunk);
+				return;
+			}
+			chunk->promoted = true;
+			this->stats.promotions += chunk->live;
+		}
+
+		void* allocate(size_t bytes)
+		{
+			bytes = align_up(sizeof(Header)) + align_up(bytes);
+
+			// Objects taking a good part of a chunk would promote it early
+			if (bytes > this->chunk_size / 4)
+			{
+				this->stats.misses++;
+				auto header = static_cast<Header*>(::operator new(bytes));
+				header->chunk = nullptr;
+				return reinterpret_cast<char*>(header) + align_up(sizeof(Header));
+			}
+
+			auto chunk = this->current;
+			if (!chunk || chunk->top + bytes > chunk->capacity)
+			{
+				chunk = this->replace();
+			}
+
+			auto header = reinterpret_cast<Header*>(chunk->data() + chunk->top);
+			header->chunk = chunk;
+			chunk->top += bytes;
+			chunk->live++;
+			this->stats.hits++;
+			return reinterpret_cast<char*>(header) + align_up(sizeof(Header));
+		}
+
+		Chunk* replace()
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			auto chunk = this->current;
+			if (chunk && chunk->live == 0 && chunk->capacity == this->chunk_size)
+			{
+				chunk->top = 0;
+			}
+			else
+			{
+				if (chunk)
+				{
+					this->promote(chunk);
+				}
+				chunk = new_chunk(this->chunk_size);
+				this->current = chunk;
+			}
+
+			this->stats.pauses++;
+			this->stats.pause_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+			return chunk;
+		}
+	};
+
+	void set_size(size_t bytes)
+	{
+		Nursery::get().chunk_size = bytes;
+	}
+
+	size_t size()
+	{
+		return Nursery::get().chunk_size;
+	}
+
+	Stats stats()
+	{
+		return Nursery::get().stats;
+	}
+
+	void reset_stats()
+	{
+		Nursery::get().stats = {};
+	}
+
+	void* allocate(size_t bytes)
+	{
+		return Nursery::get().allocate(bytes);
+	}
+
+	void release(void* ptr)
+	{
+		auto header = reinterpret_cast<Header*>(static_cast<char*>(ptr) - align_up(sizeof(Header)));
+		auto chunk = header->chunk;
+		if (!chunk)
+		{
+			::operator delete(header);
+			return;
+		}
+
+		if (--chunk->live > 0)
+			return;
+
+		// Everything in the chunk is dead, reclaim it in one go
+		if (chunk->promoted)
+		{
+			::operator delete(chunk);
+		}
+		else
+		{
+			chunk->top = 0;
+		}
+	}
+}
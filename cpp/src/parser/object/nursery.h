@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "ref.h"
+
+namespace interp::object::nursery
+{
+	// Short-lived objects (return values, tail calls, errors, strings made
+	// while evaluating) are bump allocated from the current nursery chunk.
+	// A chunk whose objects have all died is reused in place. When the chunk
+	// fills up with objects still alive it is promoted: it stays allocated as
+	// part of the old space until the last of them is released, and a fresh
+	// chunk becomes the nursery.
+	//
+	// The nursery is per thread and objects from it must be released on the
+	// thread that made them.
+
+	struct Stats
+	{
+		// Allocations served by bumping the nursery pointer
+		size_t hits;
+		// Allocations too large for a chunk, served by operator new
+		size_t misses;
+		// Objects still alive when their chunk was promoted
+		size_t promotions;
+		// Times the nursery filled up, and the time spent replacing it
+		size_t pauses;
+		uint64_t pause_ns;
+	};
+
+	constexpr size_t DEFAULT_SIZE = 64 * 1024;
+
+	// Size in bytes of the chunks made from now on
+	void set_size(size_t bytes);
+	size_t size();
+
+	Stats stats();
+	void reset_stats();
+
+	void* allocate(size_t bytes);
+	void release(void* ptr);
+
+	// Makes a T in the nursery
+	template <class T, class... Args>
+	Ref<T> make(Args&&... args)
+	{
+		static_assert(sizeof(T) <= UINT16_MAX);
+		T* obj = new (nursery::allocate(sizeof(T))) T(std::forward<Args>(args)...);
+		obj->set_storage(Storage::Nursery, sizeof(T));
+		return Ref<T>(obj);
+	}
+}
@@ -0,0 +1,216 @@
+#include <array>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "pool.h"
+
+namespace interp::object::pool
+{
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	struct FreeList
+	{
+		FreeBlock* head = nullptr;
+		size_t count = 0;
+
+		void push(void* ptr)
+		{
+			auto block = static_cast<FreeBlock*>(ptr);
+			block->next = this->head;
+			this->head = block;
+			this->count++;
+		}
+
+		void* pop()
+		{
+			auto block = this->head;
+			this->head = block->next;
+			this->count--;
+			return block;
+		}
+
+		// Moves up to n blocks from the front into a list of their own
+		FreeList take(size_t n)
+		{
+			FreeList taken;
+			for (; n > 0 && this->head; n--)
+			{
+				taken.push(this->pop());
+			}
+			return taken;
+		}
+	};
+
+	constexpr size_t size_class(size_t bytes)
+	{
+		return (bytes + GRANULE - 1) / GRANULE - 1;
+	}
+
+	constexpr size_t class_size(size_t index)
+	{
+		return (index + 1) * GRANULE;
+	}
+
+	struct Depot
+	{
+		std::mutex lock;
+		std::vector<FreeList> batches;
+#ifdef DEBUG
+		std::atomic<size_t> live = 0;
+		std::atomic<size_t> reserved = 0;
+#endif
+	};
+
+	// Never destroyed, objects may still be released by static destructors
+	std::array<Depot, CLASS_COUNT>& depots()
+	{
+		static auto depots = new std::array<Depot, CLASS_COUNT>();
+		return *depots;
+	}
+
+	// Blocks are never given back to the system, a depot keeps them for reuse
+	FreeList refill(size_t index)
+	{
+		auto& depot = depots()[index];
+		{
+			std::lock_guard<std::mutex> guard(depot.lock);
+			while (!depot.batches.empty())
+			{
+				auto batch = depot.batches.back();
+				depot.batches.pop_back();
+				// Callers pop from what they get, an empty batch is no use
+				if (batch.head)
+					return batch;
+			}
+		}
+
+		auto size = class_size(index);
+		auto slab = static_cast<char*>(::operator new(size * BATCH));
+		FreeList batch;
+		for (size_t i = BATCH; i > 0; i--)
+		{
+			batch.push(slab + (i - 1) * size);
+		}
+#ifdef DEBUG
+		depot.reserved += BATCH;
+#endif
+		return batch;
+	}
+
+	void give_back(size_t index, FreeList batch)
+	{
+		auto& depot = depots()[index];
+		std::lock_guard<std::mutex> guard(depot.lock);
+		depot.batches.push_back(batch);
+	}
+
+	struct Cache
+	{
+		std::array<FreeList, CLASS_COUNT> lists;
+
+		~Cache()
+		{
+			Cache::exited() = true;
+			for (size_t i = 0; i < CLASS_COUNT; i++)
+			{
+				while (this->lists[i].head)
+				{
+					give_back(i, this->lists[i].take(BATCH));
+				}
+			}
+		}
+
+		static Cache& get()
+		{
+			thread_local Cache cache;
+			return cache;
+		}
+
+		// Set once the thread's cache is gone, later calls use the depot
+		static bool& exited()
+		{
+			thread_local bool exited = false;
+			return exited;
+		}
+	};
+
+	void* allocate(size_t bytes)
+	{
+		if (bytes > MAX_SIZE)
+			return ::operator new(bytes);
+
+		auto index = size_class(bytes);
+#ifdef DEBUG
+		depots()[index].live++;
+#endif
+		if (Cache::exited())
+		{
+			auto batch = refill(index);
+			auto ptr = batch.pop();
+			// Batches released after exit hold a single block
+			if (batch.head)
+				give_back(index, batch);
+			return ptr;
+		}
+
+		auto& list = Cache::get().lists[index];
+		if (!list.head)
+		{
+			list = refill(index);
+		}
+		return list.pop();
+	}
+
+	void release(void* ptr, size_t bytes)
+	{
+		if (bytes > MAX_SIZE)
+		{
+			::operator delete(ptr);
+			return;
+		}
+
+		auto index = size_class(bytes);
+#ifdef DEBUG
+		depots()[index].live--;
+#endif
+		if (Cache::exited())
+		{
+			FreeList single;
+			single.push(ptr);
+			give_back(index, single);
+			return;
+		}
+
+		auto& list = Cache::get().lists[index];
+		list.push(ptr);
+		if (list.count >= 2 * BATCH)
+		{
+			give_back(index, list.take(BATCH));
+		}
+	}
+
+	void report(std::ostream& os)
+	{
+#ifdef DEBUG
+		os << std::setw(8) << "size" << std::setw(12) << "in use" << std::setw(12) << "reserved" << std::setw(12) << "occupancy" << '\n';
+		for (size_t i = 0; i < CLASS_COUNT; i++)
+		{
+			size_t live = depots()[i].live;
+			size_t reserved = depots()[i].reserved;
+			if (reserved == 0)
+				continue;
+
+			os << std::setw(8) << class_size(i) << std::setw(12) << live << std::setw(12) << reserved
+				<< std::setw(11) << std::fixed << std::setprecision(1) << 100.0 * live / reserved << "%\n";
+		}
+#else
+		os << "pool occupancy is only counted in debug builds\n";
+#endif
+	}
+}
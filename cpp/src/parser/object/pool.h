@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <utility>
+
+#include "ref.h"
+
+namespace interp::object::pool
+{
+	// Fixed size blocks for objects that live a while (environments,
+	// functions, constants), grouped in size classes of GRANULE bytes. Each
+	// thread keeps a free list per class and exchanges batches of blocks with
+	// a shared depot, so blocks may be released on any thread.
+
+	constexpr size_t GRANULE = 16;
+	constexpr size_t MAX_SIZE = 256;
+	constexpr size_t CLASS_COUNT = MAX_SIZE / GRANULE;
+	// Blocks moved between a thread's cache and the depot at once
+	constexpr size_t BATCH = 64;
+
+	// Larger requests go straight to operator new
+	void* allocate(size_t bytes);
+	void release(void* ptr, size_t bytes);
+
+	// Writes the blocks in use and reserved per size class. Only debug builds
+	// count them.
+	void report(std::ostream& os);
+
+	// Makes a T in the pool
+	template <class T, class... Args>
+	Ref<T> make(Args&&... args)
+	{
+		static_assert(sizeof(T) <= UINT16_MAX);
+		T* obj = new (pool::allocate(sizeof(T))) T(std::forward<Args>(args)...);
+		obj->set_storage(Storage::Pool, sizeof(T));
+		return Ref<T>(obj);
+	}
+}
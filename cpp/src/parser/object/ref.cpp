@@ -0,0 +1,35 @@
+#include "ref.h"
+#include "nursery.h"
+#include "pool.h"
+
+namespace interp::object
+{
+	void RefCounted::set_storage(Storage storage, size_t bytes)
+	{
+		this->storage = storage;
+		this->bytes = static_cast<uint16_t>(bytes);
+	}
+
+	void RefCounted::destroy() const
+	{
+		// The most derived object starts the allocation
+		auto memory = const_cast<void*>(dynamic_cast<const void*>(this));
+		auto storage = this->storage;
+		size_t bytes = this->bytes;
+
+		this->~RefCounted();
+
+		switch (storage)
+		{
+		case Storage::Heap:
+			::operator delete(memory);
+			break;
+		case Storage::Nursery:
+			nursery::release(memory);
+			break;
+		case Storage::Pool:
+			pool::release(memory, bytes);
+			break;
+		}
+	}
+}
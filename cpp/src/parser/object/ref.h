@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace interp::object
+{
+	// Where a RefCounted object's memory came from, so that its last release
+	// can give the memory back there.
+	enum struct Storage : uint8_t
+	{
+		Heap,
+		Nursery,
+		Pool,
+	};
+
+	// Base of objects owned through Ref. The count is a plain integer rather
+	// than an atomic: an object and every Ref to it must stay on the thread
+	// that made it, which is how an interpreter instance runs.
+	class RefCounted
+	{
+	public:
+		RefCounted() = default;
+		virtual ~RefCounted() = default;
+
+		RefCounted(const RefCounted&) = delete;
+		RefCounted& operator=(const RefCounted&) = delete;
+
+		void retain() const
+		{
+			this->refs++;
+		}
+
+		void release() const
+		{
+			if (--this->refs == 0)
+				this->destroy();
+		}
+
+		uint32_t ref_count() const
+		{
+			return this->refs;
+		}
+
+		// Called by the factories that placed the object in memory they own
+		void set_storage(Storage storage, size_t bytes);
+
+	private:
+		mutable uint32_t refs = 0;
+		uint16_t bytes = 0;
+		Storage storage = Storage::Heap;
+
+		void destroy() const;
+	};
+
+	// Owning handle to a RefCounted object, like shared_ptr without the
+	// separate control block or atomic updates.
+	template <typename T>
+	class Ref
+	{
+	public:
+		Ref()
+			: ptr(nullptr)
+		{
+		}
+
+		Ref(std::nullptr_t)
+			: ptr(nullptr)
+		{
+		}
+
+		explicit Ref(T* ptr)
+			: ptr(ptr)
+		{
+			if (this->ptr)
+				this->ptr->retain();
+		}
+
+		Ref(const Ref& other)
+			: Ref(other.ptr)
+		{
+		}
+
+		Ref(Ref&& other) noexcept
+			: ptr(std::exchange(other.ptr, nullptr))
+		{
+		}
+
+		template <typename U>
+		Ref(const Ref<U>& other)
+			: Ref(static_cast<T*>(other.ptr))
+		{
+		}
+
+		template <typename U>
+		Ref(Ref<U>&& other) noexcept
+			: ptr(std::exchange(other.ptr, nullptr))
+		{
+		}
+
+		~Ref()
+		{
+			if (this->ptr)
+				this->ptr->release();
+		}
+
+		Ref& operator=(Ref other) noexcept
+		{
+			std::swap(this->ptr, other.ptr);
+			return *this;
+		}
+
+		T* get() const
+		{
+			return this->ptr;
+		}
+
+		T* operator->() const
+		{
+			return this->ptr;
+		}
+
+		T& operator*() const
+		{
+			return *this->ptr;
+		}
+
+		explicit operator bool() const
+		{
+			return this->ptr != nullptr;
+		}
+
+		void reset()
+		{
+			Ref().swap(*this);
+		}
+
+		void swap(Ref& other) noexcept
+		{
+			std::swap(this->ptr, other.ptr);
+		}
+
+		bool operator==(const Ref& other) const
+		{
+			return this->ptr == other.ptr;
+		}
+
+	private:
+		template <typename U>
+		friend class Ref;
+
+		T* ptr;
+	};
+
+	template <typename T, typename... Args>
+	Ref<T> make_ref(Args&&... args)
+	{
+		return Ref<T>(new T(std::forward<Args>(args)...));
+	}
+}
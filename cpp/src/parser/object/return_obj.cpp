@@ -2,7 +2,7 @@
 
 namespace interp::object
 {
-	ReturnObject::ReturnObject(std::shared_ptr<Object> value)
+	ReturnObject::ReturnObject(Value value)
 		: value(value)
 	{
 	}
@@ -14,6 +14,6 @@ namespace interp::object
 
 	std::string ReturnObject::inspect() const
 	{
-		return this->value->inspect();
+		return this->value.inspect();
 	}
 }
\ No newline at end of file
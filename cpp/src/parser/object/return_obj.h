@@ -1,16 +1,17 @@
 #pragma once
 
 #include "base_obj.h"
+#include "value.h"
 
 namespace interp::object
 {
 	class ReturnObject : public Object
 	{
 	public:
-		ReturnObject(std::shared_ptr<Object> value);
+		ReturnObject(Value value);
 		~ReturnObject() = default;
 
-		std::shared_ptr<Object> value;
+		Value value;
 
 		ObjectType type() const override;
 		std::string inspect() const override;
@@ -1,10 +1,108 @@
+#include <vector>
+
 #include "string_obj.h"
+#include "nursery.h"
 
 namespace interp::object
 {
 	StringObject::StringObject(std::string value)
-		: value(value)
+		: flat(std::move(value))
+	{
+		this->size = this->flat.size();
+	}
+
+	StringObject::StringObject(Ref<StringObject> left, Ref<StringObject> right)
+		: left(std::move(left)), right(std::move(right))
+	{
+		this->size = this->left->size + this->right->size;
+	}
+
+	// A string built by appending in a loop is a chain as long as the loop,
+	// release it without recursing once per piece
+	StringObject::~StringObject()
+	{
+		std::vector<Ref<StringObject>> pending;
+		pending.push_back(std::move(this->left));
+		pending.push_back(std::move(this->right));
+		while (!pending.empty())
+		{
+			auto node = std::move(pending.back());
+			pending.pop_back();
+			if (node && node->ref_count() == 1)
+			{
+				pending.push_back(std::move(node->left));
+				pending.push_back(std::move(node->right));
+			}
+		}
+	}
+
+	Ref<StringObject> StringObject::concat(Ref<StringObject> left, Ref<StringObject> right)
+	{
+		if (left->size == 0)
+			return right;
+		if (right->size == 0)
+			return left;
+
+		if (left->size + right->size < MIN_ROPE_LENGTH)
+			return nursery::make<StringObject>(left->value() + right->value());
+
+		return nursery::make<StringObject>(std::move(left), std::move(right));
+	}
+
+	const std::string& StringObject::value() const
 	{
+		if (this->left)
+			this->flatten();
+		return this->flat;
+	}
+
+	size_t StringObject::length() const
+	{
+		return this->size;
+	}
+
+	// FNV-1a, the same on every platform so hashes iterate in a fixed order
+	uint64_t StringObject::hash() const
+	{
+		if (!this->hashed)
+		{
+			uint64_t hash = 0xcbf29ce484222325;
+			for (unsigned char ch : this->value())
+			{
+				hash = (hash ^ ch) * 0x100000001b3;
+			}
+			this->hash_value = hash;
+			this->hashed = true;
+		}
+		return this->hash_value;
+	}
+
+	// Walks the pieces in order with an explicit stack, ropes can be far
+	// deeper than the native one
+	void StringObject::flatten() const
+	{
+		std::string out;
+		out.reserve(this->size);
+
+		std::vector<const StringObject*> pending = { this };
+		while (!pending.empty())
+		{
+			auto node = pending.back();
+			pending.pop_back();
+			if (node->left)
+			{
+				pending.push_back(node->right.get());
+				pending.push_back(node->left.get());
+			}
+			else
+			{
+				out += node->flat;
+			}
+		}
+
+		this->flat = std::move(out);
+		this->left.reset();
+		this->right.reset();
 	}
 
 	ObjectType StringObject::type() const
@@ -14,6 +112,6 @@ namespace interp::object
 
 	std::string StringObject::inspect() const
 	{
-		return this->value;
+		return this->value();
 	}
-}
\ No newline at end of file
+}
@@ -1,18 +1,45 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+
 #include "base_obj.h"
 
 namespace interp::object
 {
+	// A string is either flat or a rope: the concatenation of two other
+	// strings, kept as references to them so that appending does not copy.
+	// A rope is flattened the first time its contents are needed and drops
+	// its pieces then.
 	class StringObject : public Object
 	{
 	public:
 		StringObject(std::string value);
-		~StringObject() = default;
+		StringObject(Ref<StringObject> left, Ref<StringObject> right);
+		~StringObject();
+
+		// Concatenations shorter than this are copied into a flat string,
+		// which is cheaper than a rope node for them
+		static constexpr size_t MIN_ROPE_LENGTH = 256;
+
+		static Ref<StringObject> concat(Ref<StringObject> left, Ref<StringObject> right);
 
-		std::string value;
+		const std::string& value() const;
+		size_t length() const;
+		// Hash of the contents, computed on first use and kept
+		uint64_t hash() const;
 
 		ObjectType type() const override;
 		std::string inspect() const override;
+
+	private:
+		mutable std::string flat;
+		mutable Ref<StringObject> left;
+		mutable Ref<StringObject> right;
+		size_t size;
+		mutable uint64_t hash_value = 0;
+		mutable bool hashed = false;
+
+		void flatten() const;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,19 @@
+#include "tail_call_obj.h"
+
+namespace interp::object
+{
+	TailCallObject::TailCallObject(Value function, std::vector<Value> args)
+		: function(std::move(function)), args(std::move(args))
+	{
+	}
+
+	ObjectType TailCallObject::type() const
+	{
+		return ObjectType::TailCallObject;
+	}
+
+	std::string TailCallObject::inspect() const
+	{
+		return "tail call to " + this->function.inspect();
+	}
+}
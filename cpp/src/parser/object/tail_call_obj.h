@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include "base_obj.h"
+#include "value.h"
+
+namespace interp::object
+{
+	// A call in tail position that has not been made yet. The evaluator
+	// hands it back to the apply_fn that is running the enclosing function,
+	// which makes the call in place of returning.
+	class TailCallObject : public Object
+	{
+	public:
+		TailCallObject(Value function, std::vector<Value> args);
+		~TailCallObject() = default;
+
+		Value function;
+		std::vector<Value> args;
+
+		ObjectType type() const override;
+		std::string inspect() const override;
+	};
+}
@@ -0,0 +1,72 @@
+#include "value.h"
+
+namespace interp::object
+{
+	// A tag plus one pointer
+	static_assert(sizeof(Value) <= 16);
+
+	Value::Value(Ref<Object> object)
+		: tag(object ? object->type() : EMPTY), int_value(0)
+	{
+		if (this->is_boxed())
+		{
+			new (&this->boxed) Ref<Object>(std::move(object));
+		}
+	}
+
+	Value& Value::operator=(const Value& other)
+	{
+		if (this != &other)
+		{
+			this->~Value();
+			new (this) Value(other);
+		}
+		return *this;
+	}
+
+	Value& Value::operator=(Value&& other) noexcept
+	{
+		if (this != &other)
+		{
+			this->~Value();
+			new (this) Value(std::move(other));
+		}
+		return *this;
+	}
+
+	bool Value::identical(const Value& other) const
+	{
+		if (this->tag != other.tag)
+			return false;
+
+		switch (this->tag)
+		{
+		case ObjectType::IntegerObject:
+			return this->int_value == other.int_value;
+		case ObjectType::BooleanObject:
+			return this->bool_value == other.bool_value;
+		case ObjectType::NullObject:
+		case EMPTY:
+			return true;
+		default:
+			return this->boxed == other.boxed;
+		}
+	}
+
+	std::string Value::inspect() const
+	{
+		switch (this->tag)
+		{
+		case ObjectType::IntegerObject:
+			return std::to_string(this->int_value);
+		case ObjectType::BooleanObject:
+			return this->bool_value ? "true" : "false";
+		case ObjectType::NullObject:
+			return "null";
+		case EMPTY:
+			return "";
+		default:
+			return this->boxed->inspect();
+		}
+	}
+}
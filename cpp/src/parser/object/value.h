@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "base_obj.h"
+
+namespace interp::object
+{
+	// A runtime value. Integers, booleans and null are stored inline so
+	// producing them never allocates, every other type is boxed in an Object.
+	// The members used on every evaluation step are defined here so they
+	// inline into the evaluator.
+	class Value
+	{
+	public:
+		// An empty value, what evaluating nothing produces. It is not a
+		// language value and has no type, test for it with operator bool.
+		Value()
+			: tag(EMPTY), int_value(0)
+		{
+		}
+
+		// Boxes object, or makes an empty value if it is nullptr.
+		Value(Ref<Object> object);
+		template <typename T>
+		Value(Ref<T> object)
+			: Value(Ref<Object>(std::move(object)))
+		{
+		}
+
+		Value(const Value& other)
+			: tag(other.tag), int_value(0)
+		{
+			if (this->is_boxed())
+				new (&this->boxed) Ref<Object>(other.boxed);
+			else
+				this->int_value = other.int_value;
+		}
+
+		Value(Value&& other) noexcept
+			: tag(other.tag), int_value(0)
+		{
+			if (this->is_boxed())
+				new (&this->boxed) Ref<Object>(std::move(other.boxed));
+			else
+				this->int_value = other.int_value;
+		}
+
+		~Value()
+		{
+			if (this->is_boxed())
+				this->boxed.~Ref();
+		}
+
+		Value& operator=(const Value& other);
+		Value& operator=(Value&& other) noexcept;
+
+		static Value integer(int64_t value)
+		{
+			Value out;
+			out.tag = ObjectType::IntegerObject;
+			out.int_value = value;
+			return out;
+		}
+
+		static Value boolean(bool value)
+		{
+			Value out;
+			out.tag = ObjectType::BooleanObject;
+			out.bool_value = value;
+			return out;
+		}
+
+		static Value null()
+		{
+			Value out;
+			out.tag = ObjectType::NullObject;
+			return out;
+		}
+
+		explicit operator bool() const
+		{
+			return this->tag != EMPTY;
+		}
+
+		ObjectType type() const
+		{
+			return this->tag;
+		}
+
+		int64_t as_integer() const
+		{
+			return this->int_value;
+		}
+
+		bool as_boolean() const
+		{
+			return this->bool_value;
+		}
+
+		// The boxed object, nullptr for inline and empty values.
+		Object* object() const
+		{
+			return this->is_boxed() ? this->boxed.get() : nullptr;
+		}
+
+		template <typename T>
+		T* as() const
+		{
+			return static_cast<T*>(this->object());
+		}
+
+		// Inline values are equal when their contents are, boxed ones only
+		// when they are the same object.
+		bool identical(const Value& other) const;
+		std::string inspect() const;
+
+	private:
+		// The tag of an empty value, which never names a real type.
+		static constexpr ObjectType EMPTY = ObjectType::Count;
+
+		ObjectType tag;
+		union
+		{
+			int64_t int_value;
+			bool bool_value;
+			Ref<Object> boxed;
+		};
+
+		// The inline types come first in ObjectType.
+		bool is_boxed() const
+		{
+			return this->tag > ObjectType::NullObject && this->tag != EMPTY;
+		}
+	};
+}
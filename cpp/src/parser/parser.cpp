@@ -1,54 +1,89 @@
+#include <charconv>
+
 #include "parser.h"
 
 namespace interp::parser
 {
-	std::map<token::TokenType, Precidence> precidences({
-		std::pair(token::EQUAL, Precidence::EQUALS),
-		std::pair(token::NOTEQUAL, Precidence::EQUALS),
-		std::pair(token::LESSTHANOREQUAL, Precidence::LESSGREATER),
-		std::pair(token::GREATERTHANOREQUAL, Precidence::LESSGREATER),
-		std::pair(token::LESSTHAN, Precidence::LESSGREATER),
-		std::pair(token::GREATERTHAN, Precidence::LESSGREATER),
-		std::pair(token::PLUS, Precidence::SUM),
-		std::pair(token::MINUS, Precidence::SUM),
-		std::pair(token::FORWARDSLASH, Precidence::PRODUCT),
-		std::pair(token::ASTERISK, Precidence::PRODUCT),
-		std::pair(token::LPAREN, Precidence::CALL),
-	});
-
-	Parser::Parser(interp::lexer::Lexer lexer) : lexer(lexer), prefix_parse_fns({}), infix_parse_fns({})
+	constexpr size_t token_index(token::TokenType type)
+	{
+		return static_cast<size_t>(type);
+	}
+
+	constexpr std::array<Precidence, token::TOKEN_TYPE_COUNT> precidences = []
+	{
+		std::array<Precidence, token::TOKEN_TYPE_COUNT> table{};
+		table.fill(Precidence::LOWEST);
+
+		table[token_index(token::ASSIGN)] = Precidence::ASSIGN;
+		table[token_index(token::EQUAL)] = Precidence::EQUALS;
+		table[token_index(token::NOTEQUAL)] = Precidence::EQUALS;
+		table[token_index(token::LESSTHANOREQUAL)] = Precidence::LESSGREATER;
+		table[token_index(token::GREATERTHANOREQUAL)] = Precidence::LESSGREATER;
+		table[token_index(token::LESSTHAN)] = Precidence::LESSGREATER;
+		table[token_index(token::GREATERTHAN)] = Precidence::LESSGREATER;
+		table[token_index(token::PLUS)] = Precidence::SUM;
+		table[token_index(token::MINUS)] = Precidence::SUM;
+		table[token_index(token::FORWARDSLASH)] = Precidence::PRODUCT;
+		table[token_index(token::ASTERISK)] = Precidence::PRODUCT;
+		table[token_index(token::LPAREN)] = Precidence::CALL;
+		table[token_index(token::LBRACKET)] = Precidence::INDEX;
+
+		return table;
+	}();
+
+	const std::array<PrefixParseFn, token::TOKEN_TYPE_COUNT> Parser::prefix_parse_fns = []
+	{
+		std::array<PrefixParseFn, token::TOKEN_TYPE_COUNT> table{};
+
+		table[token_index(interp::token::IDENT)] = Parser::parse_identifier;
+		table[token_index(interp::token::INT)] = Parser::parse_integer_literal;
+		table[token_index(interp::token::STRING)] = Parser::parse_string_literal;
+		table[token_index(interp::token::BANG)] = Parser::parse_prefix_expression;
+		table[token_index(interp::token::MINUS)] = Parser::parse_prefix_expression;
+		table[token_index(interp::token::TRUE)] = Parser::parse_boolean;
+		table[token_index(interp::token::FALSE)] = Parser::parse_boolean;
+		table[token_index(interp::token::LPAREN)] = Parser::parse_grouped_expression;
+		table[token_index(interp::token::IF)] = Parser::parse_if_expression;
+		table[token_index(interp::token::LBRACE)] = Parser::parse_block_expression;
+		table[token_index(interp::token::FUNCTION)] = Parser::parse_function_literal;
+		table[token_index(interp::token::LBRACKET)] = Parser::parse_array_literal;
+		table[token_index(interp::token::WHILE)] = Parser::parse_while_expression;
+		table[token_index(interp::token::FOR)] = Parser::parse_for_expression;
+
+		return table;
+	}();
+
+	const std::array<InfixParseFn, token::TOKEN_TYPE_COUNT> Parser::infix_parse_fns = []
+	{
+		std::array<InfixParseFn, token::TOKEN_TYPE_COUNT> table{};
+
+		table[token_index(interp::token::ASSIGN)] = Parser::parse_assign_expression;
+		table[token_index(interp::token::EQUAL)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::NOTEQUAL)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::LESSTHANOREQUAL)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::GREATERTHANOREQUAL)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::LESSTHAN)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::GREATERTHAN)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::PLUS)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::MINUS)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::FORWARDSLASH)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::ASTERISK)] = Parser::parse_infix_expression;
+		table[token_index(interp::token::LPAREN)] = Parser::parse_call_expression;
+		table[token_index(interp::token::LBRACKET)] = Parser::parse_index_expression;
+
+		return table;
+	}();
+
+	Parser::Parser(interp::lexer::Lexer lexer) : lexer(lexer)
 	{
 		this->next_token();
 		this->next_token();
-
-		this->prefix_parse_fns[interp::token::IDENT] = this->parse_identifier;
-		this->prefix_parse_fns[interp::token::INT] = this->parse_integer_literal;
-		this->prefix_parse_fns[interp::token::STRING] = this->parse_string_literal;
-		this->prefix_parse_fns[interp::token::BANG] = this->parse_prefix_expression;
-		this->prefix_parse_fns[interp::token::MINUS] = this->parse_prefix_expression;
-		this->prefix_parse_fns[interp::token::TRUE] = this->parse_boolean;
-		this->prefix_parse_fns[interp::token::FALSE] = this->parse_boolean;
-		this->prefix_parse_fns[interp::token::LPAREN] = this->parse_grouped_expression;
-		this->prefix_parse_fns[interp::token::IF] = this->parse_if_expression;
-		this->prefix_parse_fns[interp::token::LBRACE] = this->parse_block_expression;
-		this->prefix_parse_fns[interp::token::FUNCTION] = this->parse_function_literal;
-
-		this->infix_parse_fns[interp::token::EQUAL] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::NOTEQUAL] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::LESSTHANOREQUAL] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::GREATERTHANOREQUAL] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::LESSTHAN] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::GREATERTHAN] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::PLUS] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::MINUS] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::FORWARDSLASH] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::ASTERISK] = this->parse_infix_expression;
-		this->infix_parse_fns[interp::token::LPAREN] = this->parse_call_expression;
 	}
 
 	std::shared_ptr<interp::ast::Program> Parser::parse_program()
 	{
-		auto prog = std::shared_ptr<interp::ast::Program>(new interp::ast::Program());
+		this->arena = std::make_shared<interp::ast::AstArena>();
+		auto prog = std::make_shared<interp::ast::Program>(this->arena);
 
 		while (!this->current_token_is(interp::token::L_EOF))
 		{
@@ -71,10 +106,10 @@ namespace interp::parser
 	void Parser::next_token()
 	{
 		this->current_token = this->peek_token;
-		this->peek_token = this->lexer.next_token();
+		this->peek_token = this->lexer.next_span_token();
 	}
 
-	std::shared_ptr<interp::ast::Statement> Parser::parse_statement()
+	interp::ast::Statement* Parser::parse_statement()
 	{
 		if (this->current_token.type == interp::token::LET)
 		{
@@ -90,19 +125,20 @@ namespace interp::parser
 		}
 	}
 
-	std::shared_ptr<interp::ast::LetStatement> Parser::parse_let_statement()
+	interp::ast::LetStatement* Parser::parse_let_statement()
 	{
-		auto current = this->current_token;
+		auto current = this->current();
 
 		if (!this->expect_peek(interp::token::IDENT))
 		{
-			return std::shared_ptr<interp::ast::LetStatement>(nullptr);
+			return nullptr;
 		}
-		auto name = interp::ast::Identifier(this->current_token, this->current_token.literal);
+		auto name_token = this->current();
+		auto name = interp::ast::Identifier(name_token, name_token.literal);
 
 		if (!this->expect_peek(interp::token::ASSIGN))
 		{
-			return std::shared_ptr<interp::ast::LetStatement>(nullptr);
+			return nullptr;
 		}
 
 		this->next_token();
@@ -114,13 +150,12 @@ namespace interp::parser
 			this->next_token();
 		}
 
-		return std::shared_ptr<interp::ast::LetStatement>(
-			new interp::ast::LetStatement(current, name, value));
+		return this->arena->make<interp::ast::LetStatement>(current, name, value);
 	}
 
-	std::shared_ptr<interp::ast::ReturnStatement> Parser::parse_return_statement()
+	interp::ast::ReturnStatement* Parser::parse_return_statement()
 	{
-		auto current = this->current_token;
+		auto current = this->current();
 
 		this->next_token();
 
@@ -131,14 +166,13 @@ namespace interp::parser
 			this->next_token();
 		}
 
-		return std::shared_ptr<interp::ast::ReturnStatement>(
-			new interp::ast::ReturnStatement(current, return_value));
+		return this->arena->make<interp::ast::ReturnStatement>(current, return_value);
 	}
 
-	std::shared_ptr<interp::ast::ExpressionStatement> Parser::parse_expression_statement()
+	interp::ast::ExpressionStatement* Parser::parse_expression_statement()
 	{
-		auto exprstmnt = std::shared_ptr<interp::ast::ExpressionStatement>(
-			new interp::ast::ExpressionStatement(this->current_token, this->parse_expression(Precidence::LOWEST)));
+		auto current = this->current();
+		auto exprstmnt = this->arena->make<interp::ast::ExpressionStatement>(current, this->parse_expression(Precidence::LOWEST));
 
 		if (this->peek_token_is(interp::token::SEMICOLON))
 		{
@@ -148,67 +182,68 @@ namespace interp::parser
 		return exprstmnt;
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_expression(Precidence in_precidence)
+	interp::ast::Expression* Parser::parse_expression(Precidence in_precidence)
 	{
-		if (this->prefix_parse_fns.find(this->current_token.type) == this->prefix_parse_fns.end())
+		auto prefix = prefix_parse_fns[token_index(this->current_token.type)];
+		if (!prefix)
 		{
 			this->no_prefix_parse_fn_error(this->current_token.type);
 			return nullptr;
-			//return std::shared_ptr<interp::ast::Expression>(nullptr);
+			//return nullptr;
 		}
-		auto left_expr = this->prefix_parse_fns[this->current_token.type](this);
+		auto left_expr = prefix(this);
 
-		if (left_expr->type() == interp::ast::NodeType::BlockExpression)
+		if (!left_expr || left_expr->type() == interp::ast::NodeType::BlockExpression)
 			return left_expr;
 
 		while (!this->peek_token_is(interp::token::SEMICOLON) && in_precidence < this->peek_precidence())
 		{
-			if (this->infix_parse_fns.find(this->peek_token.type) == this->infix_parse_fns.end())
+			auto infix = infix_parse_fns[token_index(this->peek_token.type)];
+			if (!infix)
 			{
 				return left_expr;
 			}
 			this->next_token();
 
-			left_expr = this->infix_parse_fns[this->current_token.type](this, left_expr);
+			left_expr = infix(this, left_expr);
 		}
 
 		return left_expr;
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_identifier(Parser *p)
+	interp::ast::Expression* Parser::parse_identifier(Parser *p)
 	{
-		return std::shared_ptr<interp::ast::Identifier>(
-			new interp::ast::Identifier(p->current_token, p->current_token.literal));
+		auto token = p->current();
+		return p->arena->make<interp::ast::Identifier>(token, token.literal);
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_integer_literal(Parser *p)
+	interp::ast::Expression* Parser::parse_integer_literal(Parser *p)
 	{
-		try
-		{
-			auto val = std::atoll(p->current_token.literal.c_str());
-			return std::shared_ptr<interp::ast::IntegerLiteral>(
-				new interp::ast::IntegerLiteral(p->current_token, val));
-		}
-		catch (...)
+		auto literal = p->lexer.text(p->current_token.span);
+
+		int64_t val = 0;
+		auto [end, ec] = std::from_chars(literal.data(), literal.data() + literal.size(), val);
+		if (ec != std::errc() || end != literal.data() + literal.size())
 		{
-			p->errors.push_back("could not parse " + p->current_token.literal + " as an integer");
-			return std::shared_ptr<interp::ast::IntegerLiteral>(nullptr);
+			p->errors.push_back("could not parse " + std::string(literal) + " as an integer");
+			return nullptr;
 		}
+
+		return p->arena->make<interp::ast::IntegerLiteral>(p->current(), val);
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_string_literal(Parser* p)
+	interp::ast::Expression* Parser::parse_string_literal(Parser* p)
 	{
-		return std::shared_ptr<interp::ast::StringLiteral>(
-			new interp::ast::StringLiteral(p->current_token, p->current_token.literal));
+		auto token = p->current();
+		return p->arena->make<interp::ast::StringLiteral>(token, token.literal);
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_boolean(Parser *p)
+	interp::ast::Expression* Parser::parse_boolean(Parser *p)
 	{
-		return std::shared_ptr<interp::ast::BooleanLiteral>(
-			new interp::ast::BooleanLiteral(p->current_token, p->current_token_is(interp::token::TRUE)));
+		return p->arena->make<interp::ast::BooleanLiteral>(p->current(), p->current_token_is(interp::token::TRUE));
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_grouped_expression(Parser *p)
+	interp::ast::Expression* Parser::parse_grouped_expression(Parser *p)
 	{
 		p->next_token();
 
@@ -222,9 +257,9 @@ namespace interp::parser
 		return expr;
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_if_expression(Parser* p)
+	interp::ast::Expression* Parser::parse_if_expression(Parser* p)
 	{
-		auto current_token = p->current_token;
+		auto current_token = p->current();
 
 		if (!p->expect_peek(interp::token::LPAREN))
 		{
@@ -242,9 +277,7 @@ namespace interp::parser
 		p->next_token();
 		auto consequence = p->parse_expression(Precidence::LOWEST);
 
-		std::shared_ptr<interp::ast::IfExpression> if_expr = std::shared_ptr<interp::ast::IfExpression>(
-			new interp::ast::IfExpression(current_token, condition, consequence)
-		);
+		interp::ast::IfExpression* if_expr = p->arena->make<interp::ast::IfExpression>(current_token, condition, consequence);
 
 		if (p->peek_token_is(interp::token::ELSE))
 		{
@@ -257,37 +290,146 @@ namespace interp::parser
 		return if_expr;
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_block_expression(Parser* p)
+	// A block and a hash literal both start with {, the colon after a hash's
+	// first key tells them apart. {} is an empty block, {:} an empty hash.
+	interp::ast::Expression* Parser::parse_block_expression(Parser* p)
 	{
-		auto block = std::shared_ptr<interp::ast::BlockExpression>(new interp::ast::BlockExpression(p->current_token));
+		auto token = p->current();
+
+		if (p->peek_token_is(interp::token::COLON))
+		{
+			p->next_token();
+			if (!p->expect_peek(interp::token::RBRACE))
+			{
+				return nullptr;
+			}
+			return p->arena->make<interp::ast::HashLiteral>(token);
+		}
+
+		auto block = p->arena->make<interp::ast::BlockExpression>(token);
 
 		p->next_token();
 
-		while (!p->current_token_is(interp::token::L_EOF) && !p->current_token_is(interp::token::RBRACE))
+		if (prefix_parse_fns[token_index(p->current_token.type)])
+		{
+			auto statement_token = p->current();
+			auto expr = p->parse_expression(Precidence::LOWEST);
+			if (p->peek_token_is(interp::token::COLON))
+			{
+				return p->parse_hash_literal(token, expr);
+			}
+
+			block->statements.push_back(p->arena->make<interp::ast::ExpressionStatement>(statement_token, expr));
+			if (p->peek_token_is(interp::token::SEMICOLON))
+			{
+				p->next_token();
+			}
+			p->next_token();
+		}
+
+		p->parse_block_statements(block);
+
+		return block;
+	}
+
+	// Statements from the current token up to the closing brace
+	void Parser::parse_block_statements(interp::ast::BlockExpression* block)
+	{
+		while (!this->current_token_is(interp::token::L_EOF) && !this->current_token_is(interp::token::RBRACE))
 		{
-			auto stmnt = p->parse_statement();
+			auto stmnt = this->parse_statement();
 			if (stmnt)
 			{
 				block->statements.push_back(stmnt);
 			}
-			p->next_token();
+			this->next_token();
+		}
+	}
+
+	// A loop body is always a block, never a hash
+	interp::ast::BlockExpression* Parser::parse_loop_body()
+	{
+		if (!this->expect_peek(interp::token::LBRACE))
+		{
+			return nullptr;
 		}
 
+		auto block = this->arena->make<interp::ast::BlockExpression>(this->current());
+		this->next_token();
+		this->parse_block_statements(block);
+
 		return block;
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_function_literal(Parser *p)
+	interp::ast::Expression* Parser::parse_while_expression(Parser* p)
 	{
-		auto current_token = p->current_token;
+		auto current_token = p->current();
 
 		if (!p->expect_peek(interp::token::LPAREN))
 		{
 			return nullptr;
 		}
 
-		auto fn_lit = std::shared_ptr<interp::ast::FunctionLiteral>(
-			new interp::ast::FunctionLiteral(current_token)
-		);
+		p->next_token();
+		auto condition = p->parse_expression(Precidence::LOWEST);
+
+		if (!p->expect_peek(interp::token::RPAREN))
+		{
+			return nullptr;
+		}
+
+		auto body = p->parse_loop_body();
+		if (!body)
+		{
+			return nullptr;
+		}
+
+		return p->arena->make<interp::ast::WhileExpression>(current_token, condition, body);
+	}
+
+	interp::ast::Expression* Parser::parse_for_expression(Parser* p)
+	{
+		auto current_token = p->current();
+
+		if (!p->expect_peek(interp::token::LPAREN) || !p->expect_peek(interp::token::IDENT))
+		{
+			return nullptr;
+		}
+		auto name_token = p->current();
+		auto variable = interp::ast::Identifier(name_token, name_token.literal);
+
+		if (!p->expect_peek(interp::token::IN))
+		{
+			return nullptr;
+		}
+
+		p->next_token();
+		auto iterable = p->parse_expression(Precidence::LOWEST);
+
+		if (!p->expect_peek(interp::token::RPAREN))
+		{
+			return nullptr;
+		}
+
+		auto body = p->parse_loop_body();
+		if (!body)
+		{
+			return nullptr;
+		}
+
+		return p->arena->make<interp::ast::ForExpression>(current_token, variable, iterable, body);
+	}
+
+	interp::ast::Expression* Parser::parse_function_literal(Parser *p)
+	{
+		auto current_token = p->current();
+
+		if (!p->expect_peek(interp::token::LPAREN))
+		{
+			return nullptr;
+		}
+
+		auto fn_lit = p->arena->make<interp::ast::FunctionLiteral>(current_token, p->arena.get());
 		p->parse_function_parameters(fn_lit->params);
 
 		p->next_token();
@@ -297,7 +439,45 @@ namespace interp::parser
 		return fn_lit;
 	}
 
-	void Parser::parse_function_parameters(std::vector<std::shared_ptr<interp::ast::Identifier>>& out_params)
+	interp::ast::Expression* Parser::parse_array_literal(Parser* p)
+	{
+		auto array = p->arena->make<interp::ast::ArrayLiteral>(p->current());
+
+		p->parse_expression_list(interp::token::RBRACKET, array->elements);
+
+		return array;
+	}
+
+	// Parses the rest of a hash literal whose first key has been read
+	interp::ast::Expression* Parser::parse_hash_literal(interp::token::Token token, interp::ast::Expression* first_key)
+	{
+		auto hash = this->arena->make<interp::ast::HashLiteral>(token);
+
+		auto key = first_key;
+		while (true)
+		{
+			if (!this->expect_peek(interp::token::COLON))
+			{
+				return nullptr;
+			}
+			this->next_token();
+			hash->pairs.emplace_back(key, this->parse_expression(Precidence::LOWEST));
+
+			if (this->peek_token_is(interp::token::RBRACE))
+			{
+				this->next_token();
+				return hash;
+			}
+			if (!this->expect_peek(interp::token::COMMA))
+			{
+				return nullptr;
+			}
+			this->next_token();
+			key = this->parse_expression(Precidence::LOWEST);
+		}
+	}
+
+	void Parser::parse_function_parameters(std::vector<interp::ast::Identifier*>& out_params)
 	{
 		if (this->peek_token_is(interp::token::RPAREN))
 		{
@@ -308,9 +488,8 @@ namespace interp::parser
 		do
 		{
 			this->next_token();
-			out_params.push_back(std::shared_ptr<interp::ast::Identifier>(
-				new interp::ast::Identifier(this->current_token, this->current_token.literal)
-			));
+			auto token = this->current();
+			out_params.push_back(this->arena->make<interp::ast::Identifier>(token, token.literal));
 			this->next_token();
 		} while (this->current_token_is(interp::token::COMMA));
 
@@ -320,48 +499,77 @@ namespace interp::parser
 		}
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_prefix_expression(Parser *p)
+	interp::ast::Expression* Parser::parse_prefix_expression(Parser *p)
 	{
-		auto current_token = p->current_token;
+		auto current_token = p->current();
 		p->next_token();
-		return std::shared_ptr<interp::ast::PrefixExpression>(
-			new interp::ast::PrefixExpression(
+		return p->arena->make<interp::ast::PrefixExpression>(
 				current_token,
 				current_token.literal,
+				interp::ast::operator_from_token(current_token.type),
 				p->parse_expression(Precidence::PREFIX)
-			)
-		);
+			);
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_infix_expression(Parser *p, std::shared_ptr<interp::ast::Expression> left)
+	interp::ast::Expression* Parser::parse_infix_expression(Parser *p, interp::ast::Expression* left)
 	{
-		auto current_token = p->current_token;
+		auto current_token = p->current();
 		auto current_precidence = p->curr_precidence();
 		p->next_token();
-		return std::shared_ptr<interp::ast::InfixExpression>(
-			new interp::ast::InfixExpression(
+		return p->arena->make<interp::ast::InfixExpression>(
 				current_token,
 				left,
 				current_token.literal,
+				interp::ast::operator_from_token(current_token.type),
 				p->parse_expression(current_precidence)
-			)
-		);
+			);
 	}
 
-	std::shared_ptr<interp::ast::Expression> Parser::parse_call_expression(Parser *p, std::shared_ptr<interp::ast::Expression> left)
+	interp::ast::Expression* Parser::parse_call_expression(Parser *p, interp::ast::Expression* left)
 	{
-		auto call = std::shared_ptr<interp::ast::CallExpression>(
-			new interp::ast::CallExpression(p->current_token, left)
-		);
+		auto call = p->arena->make<interp::ast::CallExpression>(p->current(), left);
 
-		p->parse_call_arguments(call->args);
+		p->parse_expression_list(interp::token::RPAREN, call->args);
 
 		return call;
 	}
 
-	void Parser::parse_call_arguments(std::vector<std::shared_ptr<interp::ast::Expression>>& out_args)
+	interp::ast::Expression* Parser::parse_index_expression(Parser* p, interp::ast::Expression* left)
 	{
-		if (this->peek_token_is(interp::token::RPAREN))
+		auto current_token = p->current();
+
+		p->next_token();
+		auto index = p->parse_expression(Precidence::LOWEST);
+
+		if (!p->expect_peek(interp::token::RBRACKET))
+		{
+			return nullptr;
+		}
+
+		return p->arena->make<interp::ast::IndexExpression>(current_token, left, index);
+	}
+
+	// Right associative, a = b = c assigns c to both
+	interp::ast::Expression* Parser::parse_assign_expression(Parser* p, interp::ast::Expression* left)
+	{
+		auto current_token = p->current();
+
+		if (!left || left->type() != interp::ast::NodeType::Identifier)
+		{
+			p->errors.push_back("cannot assign to " + (left ? left->string() : std::string("nothing")));
+			return nullptr;
+		}
+
+		p->next_token();
+		auto value = p->parse_expression(Precidence::LOWEST);
+
+		return p->arena->make<interp::ast::AssignExpression>(current_token, static_cast<interp::ast::Identifier*>(left), value);
+	}
+
+	// Comma separated expressions up to and including end
+	void Parser::parse_expression_list(interp::token::TokenType end, std::vector<interp::ast::Expression*>& out_list)
+	{
+		if (this->peek_token_is(end))
 		{
 			this->next_token();
 			return;
@@ -370,16 +578,21 @@ namespace interp::parser
 		do
 		{
 			this->next_token();
-			out_args.push_back(this->parse_expression(Precidence::LOWEST));
+			out_list.push_back(this->parse_expression(Precidence::LOWEST));
 			this->next_token();
 		} while (this->current_token_is(interp::token::COMMA));
 
-		if (!this->current_token_is(interp::token::RPAREN))
+		if (!this->current_token_is(end))
 		{
-			this->current_error(interp::token::RPAREN);
+			this->current_error(end);
 		}
 	}
 
+	interp::token::Token Parser::current()
+	{
+		return this->lexer.materialize(this->current_token);
+	}
+
 	bool Parser::current_token_is(interp::token::TokenType type)
 	{
 		return this->current_token.type == type;
@@ -406,39 +619,27 @@ namespace interp::parser
 
 	void Parser::current_error(interp::token::TokenType type)
 	{
-		this->errors.push_back("Expected current token to be " + type + ", got " + this->current_token.type + " instead");
+		this->errors.push_back("Expected current token to be " + token::token_type_to_string(type) + ", got " + token::token_type_to_string(this->current_token.type) + " instead");
 	}
 
 	void Parser::peek_error(interp::token::TokenType type)
 	{
-		this->errors.push_back("Expected next token to be " + type + ", got " + this->peek_token.type + " instead");
+		this->errors.push_back("Expected next token to be " + token::token_type_to_string(type) + ", got " + token::token_type_to_string(this->peek_token.type) + " instead");
 	}
 
 	void Parser::no_prefix_parse_fn_error(interp::token::TokenType type)
 	{
-		this->errors.push_back("No prefix parse fn found for " + type);
+		this->errors.push_back("No prefix parse fn found for " + token::token_type_to_string(type));
 	}
 
 	Precidence Parser::peek_precidence()
 	{
-		if (precidences.find(this->peek_token.type) == precidences.end())
-		{
-			return Precidence::LOWEST;
-		}
-		else {
-			return precidences[this->peek_token.type];
-		}
+		return precidences[token_index(this->peek_token.type)];
 	}
 
 	Precidence Parser::curr_precidence()
 	{
-		if (precidences.find(this->current_token.type) == precidences.end())
-		{
-			return Precidence::LOWEST;
-		}
-		else {
-			return precidences[this->current_token.type];
-		}
+		return precidences[token_index(this->current_token.type)];
 	}
 
 }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <memory>
 #include <vector>
-#include <map>
 
 #include "lexer/token.h"
 #include "lexer/lexer.h"
@@ -14,14 +14,21 @@ namespace interp::parser
 	enum struct Precidence
 	{
 		LOWEST,
+		ASSIGN,		 // x = y
 		EQUALS,		 // ==
 		LESSGREATER, // > or < or <= or >=
 		SUM,		 // +
 		PRODUCT,	 // *
 		PREFIX,		 // -X or !X
 		CALL,		 // myFunction(X)
+		INDEX,		 // array[index]
 	};
 
+	class Parser;
+
+	typedef interp::ast::Expression* (*PrefixParseFn)(Parser *);
+	typedef interp::ast::Expression* (*InfixParseFn)(Parser *, interp::ast::Expression*);
+
 	class Parser
 	{
 	public:
@@ -33,33 +40,44 @@ namespace interp::parser
 
 	private:
 		interp::lexer::Lexer lexer;
-		interp::token::Token current_token;
-		interp::token::Token peek_token;
+		interp::token::SpanToken current_token;
+		interp::token::SpanToken peek_token;
 		std::vector<std::string> errors;
+		std::shared_ptr<interp::ast::AstArena> arena;
 
-		std::map<interp::token::TokenType, std::shared_ptr<interp::ast::Expression> (*)(Parser *)> prefix_parse_fns;
-		std::map<interp::token::TokenType, std::shared_ptr<interp::ast::Expression> (*)(Parser *, std::shared_ptr<interp::ast::Expression>)> infix_parse_fns;
+		// Indexed by TokenType, nullptr where a token has no parse fn
+		static const std::array<PrefixParseFn, interp::token::TOKEN_TYPE_COUNT> prefix_parse_fns;
+		static const std::array<InfixParseFn, interp::token::TOKEN_TYPE_COUNT> infix_parse_fns;
 
 		void next_token();
-		std::shared_ptr<interp::ast::Statement> parse_statement();
-		std::shared_ptr<interp::ast::LetStatement> parse_let_statement();
-		std::shared_ptr<interp::ast::ReturnStatement> parse_return_statement();
-		std::shared_ptr<interp::ast::ExpressionStatement> parse_expression_statement();
-		std::shared_ptr<interp::ast::Expression> parse_expression(Precidence);
-		static std::shared_ptr<interp::ast::Expression> parse_identifier(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_integer_literal(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_string_literal(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_boolean(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_grouped_expression(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_if_expression(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_block_expression(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_function_literal(Parser *);
-		void parse_function_parameters(std::vector<std::shared_ptr<interp::ast::Identifier>> &);
-		static std::shared_ptr<interp::ast::Expression> parse_prefix_expression(Parser *);
-		static std::shared_ptr<interp::ast::Expression> parse_infix_expression(Parser *, std::shared_ptr<interp::ast::Expression> left);
-		static std::shared_ptr<interp::ast::Expression> parse_call_expression(Parser *, std::shared_ptr<interp::ast::Expression> left);
-		void parse_call_arguments(std::vector<std::shared_ptr<interp::ast::Expression>> &);
+		interp::ast::Statement* parse_statement();
+		interp::ast::LetStatement* parse_let_statement();
+		interp::ast::ReturnStatement* parse_return_statement();
+		interp::ast::ExpressionStatement* parse_expression_statement();
+		interp::ast::Expression* parse_expression(Precidence);
+		static interp::ast::Expression* parse_identifier(Parser *);
+		static interp::ast::Expression* parse_integer_literal(Parser *);
+		static interp::ast::Expression* parse_string_literal(Parser *);
+		static interp::ast::Expression* parse_boolean(Parser *);
+		static interp::ast::Expression* parse_grouped_expression(Parser *);
+		static interp::ast::Expression* parse_if_expression(Parser *);
+		static interp::ast::Expression* parse_block_expression(Parser *);
+		void parse_block_statements(interp::ast::BlockExpression*);
+		interp::ast::BlockExpression* parse_loop_body();
+		static interp::ast::Expression* parse_while_expression(Parser *);
+		static interp::ast::Expression* parse_for_expression(Parser *);
+		static interp::ast::Expression* parse_function_literal(Parser *);
+		static interp::ast::Expression* parse_array_literal(Parser *);
+		interp::ast::Expression* parse_hash_literal(interp::token::Token token, interp::ast::Expression* first_key);
+		void parse_function_parameters(std::vector<interp::ast::Identifier*> &);
+		static interp::ast::Expression* parse_prefix_expression(Parser *);
+		static interp::ast::Expression* parse_infix_expression(Parser *, interp::ast::Expression* left);
+		static interp::ast::Expression* parse_call_expression(Parser *, interp::ast::Expression* left);
+		static interp::ast::Expression* parse_index_expression(Parser *, interp::ast::Expression* left);
+		static interp::ast::Expression* parse_assign_expression(Parser *, interp::ast::Expression* left);
+		void parse_expression_list(interp::token::TokenType end, std::vector<interp::ast::Expression*> &);
 
+		interp::token::Token current();
 		bool current_token_is(interp::token::TokenType type);
 		bool peek_token_is(interp::token::TokenType type);
 		bool expect_peek(interp::token::TokenType type);
@@ -0,0 +1,343 @@
+#include <algorithm>
+
+#include "resolver.h"
+#include "builtins/builtins.h"
+
+namespace interp::parser
+{
+	Resolver::Resolver(interp::object::Environment& globals)
+		: globals(globals)
+	{
+	}
+
+	void Resolver::resolve(interp::ast::Program* program)
+	{
+		this->scopes.clear();
+		this->functions = 0;
+		this->closures = 0;
+		this->begin_scope();
+
+		auto& names = this->globals.names();
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			this->scopes.back().slots[names[i]] = static_cast<uint32_t>(i);
+		}
+
+		for (auto statement : program->statements)
+		{
+			this->resolve_node(statement);
+		}
+
+		this->end_scope();
+	}
+
+	void Resolver::resolve_node(interp::ast::Node* node)
+	{
+		if (!node)
+			return;
+
+		switch (node->type())
+		{
+		case interp::ast::NodeType::ArrayLiteral:
+		{
+			auto literal = static_cast<interp::ast::ArrayLiteral*>(node);
+			for (auto element : literal->elements)
+			{
+				this->resolve_node(element);
+			}
+			break;
+		}
+		case interp::ast::NodeType::AssignExpression:
+		{
+			auto literal = static_cast<interp::ast::AssignExpression*>(node);
+			this->resolve_node(literal->value);
+			this->resolve_identifier(literal->name);
+			break;
+		}
+		case interp::ast::NodeType::BlockExpression:
+		{
+			// Outside every function and loop a block's variables would be
+			// globals, so there a block that declares any keeps its own
+			// environment. It only runs once per program anyway.
+			auto literal = static_cast<interp::ast::BlockExpression*>(node);
+			literal->own_env = this->env_scope() == 0 && std::any_of(literal->statements.begin(), literal->statements.end(),
+				[](interp::ast::Statement* statement) { return statement->type() == interp::ast::NodeType::LetStatment; });
+			this->begin_scope(literal->own_env);
+			for (auto statement : literal->statements)
+			{
+				this->resolve_node(statement);
+			}
+			literal->locals = this->end_scope();
+			break;
+		}
+		case interp::ast::NodeType::CallExpression:
+		{
+			auto literal = static_cast<interp::ast::CallExpression*>(node);
+			this->resolve_node(literal->function);
+			for (auto arg : literal->args)
+			{
+				this->resolve_node(arg);
+			}
+			break;
+		}
+		case interp::ast::NodeType::ExpressionStatment:
+		{
+			auto literal = static_cast<interp::ast::ExpressionStatement*>(node);
+			this->resolve_node(literal->expression);
+			break;
+		}
+		case interp::ast::NodeType::ForExpression:
+		{
+			// The iterable is evaluated once, outside the loop's scope
+			auto literal = static_cast<interp::ast::ForExpression*>(node);
+			this->resolve_node(literal->iterable);
+			this->begin_scope();
+			literal->variable.depth = 0;
+			literal->variable.slot = this->declare(literal->variable.name);
+			this->resolve_loop_body(literal->body, this->closures, literal->locals, literal->captures);
+			break;
+		}
+		case interp::ast::NodeType::FunctionLiteral:
+		{
+			auto literal = static_cast<interp::ast::FunctionLiteral*>(node);
+			this->closures++;
+			this->begin_scope();
+			this->scopes.back().is_function = true;
+			for (auto param : literal->params)
+			{
+				param->depth = 0;
+				param->slot = this->declare(param->name);
+			}
+			this->functions++;
+			this->resolve_node(literal->body);
+			this->functions--;
+			this->mark_tail_calls(literal->body);
+			literal->locals = this->end_scope();
+			break;
+		}
+		case interp::ast::NodeType::HashLiteral:
+		{
+			auto literal = static_cast<interp::ast::HashLiteral*>(node);
+			for (auto& [key, value] : literal->pairs)
+			{
+				this->resolve_node(key);
+				this->resolve_node(value);
+			}
+			break;
+		}
+		case interp::ast::NodeType::Identifier:
+		{
+			this->resolve_identifier(static_cast<interp::ast::Identifier*>(node));
+			break;
+		}
+		case interp::ast::NodeType::IfExpression:
+		{
+			auto literal = static_cast<interp::ast::IfExpression*>(node);
+			this->resolve_node(literal->condition);
+			this->resolve_node(literal->consequence);
+			this->resolve_node(literal->alternative);
+			break;
+		}
+		case interp::ast::NodeType::IndexExpression:
+		{
+			auto literal = static_cast<interp::ast::IndexExpression*>(node);
+			this->resolve_node(literal->left);
+			this->resolve_node(literal->index);
+			break;
+		}
+		case interp::ast::NodeType::InfixExpression:
+		{
+			auto literal = static_cast<interp::ast::InfixExpression*>(node);
+			this->resolve_node(literal->left);
+			this->resolve_node(literal->right);
+			break;
+		}
+		case interp::ast::NodeType::LetStatment:
+		{
+			// The value is resolved first: like evaluation, it still sees any
+			// outer variable the let is about to shadow.
+			auto literal = static_cast<interp::ast::LetStatement*>(node);
+			this->resolve_node(literal->value);
+			literal->name.depth = 0;
+			literal->name.slot = this->declare(literal->name.name);
+			break;
+		}
+		case interp::ast::NodeType::PrefixExpression:
+		{
+			auto literal = static_cast<interp::ast::PrefixExpression*>(node);
+			this->resolve_node(literal->right);
+			break;
+		}
+		case interp::ast::NodeType::ReturnStatment:
+		{
+			auto literal = static_cast<interp::ast::ReturnStatement*>(node);
+			this->resolve_node(literal->return_value);
+			if (this->functions > 0)
+				this->mark_tail_calls(literal->return_value);
+			break;
+		}
+		case interp::ast::NodeType::WhileExpression:
+		{
+			auto literal = static_cast<interp::ast::WhileExpression*>(node);
+			this->begin_scope();
+			auto closures = this->closures;
+			this->resolve_node(literal->condition);
+			this->resolve_loop_body(literal->body, closures, literal->locals, literal->captures);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// Resolves the statements of a loop's body in the loop's scope, which the
+	// caller began, and ends it. closures is the count from before the loop.
+	void Resolver::resolve_loop_body(interp::ast::BlockExpression* body, size_t closures, uint32_t& locals, bool& captures)
+	{
+		for (auto statement : body->statements)
+		{
+			this->resolve_node(statement);
+		}
+		captures = this->closures != closures;
+		locals = this->end_scope();
+	}
+
+	// Only the scopes of the innermost function are searched right away. A
+	// name from outside it is left pending, since an enclosing function may
+	// still declare it further on, and that declaration shadows any outer one.
+	void Resolver::resolve_identifier(interp::ast::Identifier* ident)
+	{
+		uint32_t depth = 0;
+		for (auto scope = this->scopes.rbegin(); scope != this->scopes.rend(); scope++)
+		{
+			auto found = scope->slots.find(ident->name);
+			if (found != scope->slots.end())
+			{
+				ident->depth = depth;
+				ident->slot = found->second;
+				return;
+			}
+			if (scope->is_function)
+				break;
+			if (scope->has_env)
+				depth++;
+		}
+
+		this->scopes.back().pending.emplace_back(ident, 0, false);
+	}
+
+	// Marks the calls whose value node evaluates to: the last statement of a
+	// block and both branches of an if.
+	void Resolver::mark_tail_calls(interp::ast::Node* node)
+	{
+		if (!node)
+			return;
+
+		switch (node->type())
+		{
+		case interp::ast::NodeType::BlockExpression:
+		{
+			auto literal = static_cast<interp::ast::BlockExpression*>(node);
+			if (!literal->statements.empty())
+				this->mark_tail_calls(literal->statements.back());
+			break;
+		}
+		case interp::ast::NodeType::CallExpression:
+		{
+			static_cast<interp::ast::CallExpression*>(node)->tail = true;
+			break;
+		}
+		case interp::ast::NodeType::ExpressionStatment:
+		{
+			this->mark_tail_calls(static_cast<interp::ast::ExpressionStatement*>(node)->expression);
+			break;
+		}
+		case interp::ast::NodeType::IfExpression:
+		{
+			auto literal = static_cast<interp::ast::IfExpression*>(node);
+			this->mark_tail_calls(literal->consequence);
+			this->mark_tail_calls(literal->alternative);
+			break;
+		}
+		case interp::ast::NodeType::ReturnStatment:
+		{
+			this->mark_tail_calls(static_cast<interp::ast::ReturnStatement*>(node)->return_value);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	uint32_t Resolver::declare(interp::lexer::Atom name)
+	{
+		auto& scope = this->scopes.back();
+
+		auto found = scope.slots.find(name);
+		if (found != scope.slots.end())
+			return found->second;
+
+		uint32_t slot = this->scopes.size() == 1
+			? this->globals.declare(name)
+			: this->scopes[this->env_scope()].size++;
+		scope.slots[name] = slot;
+		return slot;
+	}
+
+	// Index of the innermost scope with an environment
+	size_t Resolver::env_scope() const
+	{
+		size_t index = this->scopes.size() - 1;
+		while (!this->scopes[index].has_env)
+		{
+			index--;
+		}
+		return index;
+	}
+
+	void Resolver::begin_scope(bool has_env)
+	{
+		this->scopes.emplace_back();
+		this->scopes.back().has_env = has_env;
+	}
+
+	// Returns the number of slots the scope's environment needs.
+	uint32_t Resolver::end_scope()
+	{
+		auto pending = std::move(this->scopes.back().pending);
+		bool is_global = this->scopes.size() == 1;
+		uint32_t outer_depth = this->scopes.back().has_env ? 1 : 0;
+		bool is_function = this->scopes.back().is_function;
+
+		for (auto& [ident, depth, in_function] : pending)
+		{
+			// Globals are looked up at run time, so every program sees the
+			// same slot whatever order it declares them in
+			auto& slots = this->scopes.back().slots;
+			auto found = slots.find(ident->name);
+			if (found != slots.end() && (in_function || is_global))
+			{
+				ident->depth = depth;
+				ident->slot = found->second;
+			}
+			else if (is_global)
+			{
+				// Still unknown, give it a global slot holding the builtin of
+				// that name. Without one using it is an error until something
+				// declares it, possibly a later program.
+				ident->depth = depth;
+				ident->slot = this->declare(ident->name);
+				if (auto index = interp::eval::find_builtin(ident->name))
+					this->globals.set(ident->slot, interp::eval::builtin(*index));
+			}
+			else
+			{
+				this->scopes[this->scopes.size() - 2].pending.emplace_back(ident, depth + outer_depth, in_function || is_function);
+			}
+		}
+
+		auto size = this->scopes.back().size;
+		this->scopes.pop_back();
+		return size;
+	}
+}
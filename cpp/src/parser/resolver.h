@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ast.h"
+#include "lexer/atom.h"
+#include "object/environment.h"
+
+namespace interp::parser
+{
+	// Gives every identifier in a program the lexical address (depth, slot) of
+	// the variable it names, so evaluation indexes environments instead of
+	// looking names up. Scopes mirror the environments the evaluator creates:
+	// the global one, one per function call and one per loop, shared by its
+	// body. Blocks are scopes for naming only: their variables take slots in
+	// the environment of the function or loop they are in, so evaluating a
+	// block allocates nothing. Calls in tail position are marked along the way.
+	class Resolver
+	{
+	public:
+		// Top level names resolve to, and are declared in, globals.
+		Resolver(interp::object::Environment& globals);
+		~Resolver() = default;
+
+		void resolve(interp::ast::Program* program);
+
+	private:
+		struct Scope
+		{
+			std::unordered_map<interp::lexer::Atom, uint32_t, interp::lexer::Atom::Hash> slots;
+			// Identifiers that named nothing visible in their function when
+			// they were reached, with their depth relative to this scope and
+			// whether they are in a function nested in it. Those are retried
+			// once the scope is complete, which is how functions can refer to
+			// variables declared after them. The others run before any later
+			// declaration, so they keep looking outwards.
+			std::vector<std::tuple<interp::ast::Identifier*, uint32_t, bool>> pending;
+			// Whether the scope holds a function's parameters
+			bool is_function = false;
+			// Whether the scope has an environment at run time
+			bool has_env = true;
+			// Slots taken in that environment, by the scope and the scopes
+			// without one inside it
+			uint32_t size = 0;
+		};
+
+		interp::object::Environment& globals;
+		std::vector<Scope> scopes;
+		// Number of function literals being resolved
+		size_t functions = 0;
+		// Number of function literals resolved so far, a loop whose body
+		// changes it can capture its environment
+		size_t closures = 0;
+
+		void resolve_node(interp::ast::Node* node);
+		void resolve_identifier(interp::ast::Identifier* ident);
+		void resolve_loop_body(interp::ast::BlockExpression* body, size_t closures, uint32_t& locals, bool& captures);
+		void mark_tail_calls(interp::ast::Node* node);
+		uint32_t declare(interp::lexer::Atom name);
+		size_t env_scope() const;
+		void begin_scope(bool has_env = true);
+		uint32_t end_scope();
+	};
+}
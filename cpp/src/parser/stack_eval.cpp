@@ -0,0 +1,475 @@
+#include "stack_eval.h"
+#include "eval.h"
+#include "folder.h"
+#include "resolver.h"
+
+namespace interp::eval
+{
+	StackEvaluator::StackEvaluator(size_t max_depth)
+		: max_depth(max_depth)
+	{
+	}
+
+	interp::object::Value StackEvaluator::run(interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env)
+	{
+		interp::parser::Folder(*program->arena).fold(program);
+		interp::parser::Resolver(*env).resolve(program);
+
+		if (program->statements.empty())
+			return interp::object::Value();
+
+		this->frames.clear();
+		this->values.clear();
+		this->depth = 0;
+		this->env = env;
+		this->push(program);
+
+		while (!this->frames.empty())
+		{
+			auto& frame = this->frames.back();
+
+			// Function call boundary, the body's value is on the stack
+			if (!frame.node)
+			{
+				this->env = std::move(frame.env);
+				this->depth--;
+				this->frames.pop_back();
+				continue;
+			}
+
+			switch (frame.node->type())
+			{
+			case interp::ast::NodeType::ArrayLiteral:
+			{
+				auto literal = static_cast<interp::ast::ArrayLiteral*>(frame.node);
+				if (frame.step < literal->elements.size())
+				{
+					this->push(literal->elements[frame.step++]);
+					break;
+				}
+
+				auto first = this->values.end() - literal->elements.size();
+				std::vector<interp::object::Value> elements(std::make_move_iterator(first), std::make_move_iterator(this->values.end()));
+				this->values.erase(first, this->values.end());
+				this->values.push_back(interp::object::pool::make<interp::object::ArrayObject>(std::move(elements)));
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::AssignExpression:
+			{
+				auto literal = static_cast<interp::ast::AssignExpression*>(frame.node);
+				if (frame.step == 0)
+				{
+					frame.step++;
+					this->push(literal->value);
+					break;
+				}
+
+				if (!this->env->assign(literal->name->depth, literal->name->slot, this->values.back()))
+					return new_error("identifier not found: " + literal->name->value);
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::Program:
+			case interp::ast::NodeType::BlockExpression:
+			{
+				auto& statements = frame.node->type() == interp::ast::NodeType::Program
+					? static_cast<interp::ast::Program*>(frame.node)->statements
+					: static_cast<interp::ast::BlockExpression*>(frame.node)->statements;
+
+				if (frame.step == 0 && frame.node->type() == interp::ast::NodeType::BlockExpression)
+				{
+					auto block = static_cast<interp::ast::BlockExpression*>(frame.node);
+					if (block->own_env)
+					{
+						frame.env = this->env;
+						this->env = interp::object::Environment::new_env(this->env, block->locals);
+					}
+
+					if (statements.empty())
+					{
+						this->values.push_back(interp::object::Value::null());
+						if (frame.env)
+							this->env = std::move(frame.env);
+						this->frames.pop_back();
+						break;
+					}
+				}
+
+				if (frame.step < statements.size())
+				{
+					// Only the value of the last statement is kept
+					if (frame.step > 0)
+						this->values.pop_back();
+					this->push(statements[frame.step++]);
+					break;
+				}
+
+				if (frame.env)
+					this->env = std::move(frame.env);
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::BooleanExpression:
+			{
+				auto literal = static_cast<interp::ast::BooleanLiteral*>(frame.node);
+				this->values.push_back(interp::object::Value::boolean(literal->value));
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::CallExpression:
+			{
+				auto literal = static_cast<interp::ast::CallExpression*>(frame.node);
+				if (frame.step == 0)
+				{
+					frame.step++;
+					this->push(literal->function);
+					break;
+				}
+				if (frame.step <= literal->args.size())
+				{
+					this->push(literal->args[frame.step++ - 1]);
+					break;
+				}
+
+				auto callee = this->values.size() - literal->args.size() - 1;
+				if (this->values[callee].type() == interp::object::ObjectType::BuiltinFnObject)
+				{
+					auto result = this->values[callee].as<interp::object::BuiltinFnObject>()->value(
+						std::span<const interp::object::Value>(this->values.data() + callee + 1, literal->args.size()));
+					if (is_error(result))
+						return result;
+					this->values.resize(callee);
+					this->values.push_back(std::move(result));
+					this->frames.pop_back();
+					break;
+				}
+
+				std::vector<interp::object::Value> args(
+					std::make_move_iterator(this->values.begin() + callee + 1),
+					std::make_move_iterator(this->values.end()));
+				auto fn = std::move(this->values[callee]);
+				this->values.resize(callee);
+
+				if (fn.type() != interp::object::ObjectType::FunctionObject)
+				{
+					auto result = apply_fn(fn, args);
+					if (is_error(result))
+						return result;
+					this->values.push_back(std::move(result));
+					this->frames.pop_back();
+					break;
+				}
+
+				auto fn_obj = fn.as<interp::object::FunctionObject>();
+				auto fn_env = extend_fn_env(fn_obj, args);
+
+				if (literal->tail && this->depth > 0)
+				{
+					// Take over the frame of the function this call ends
+					this->unwind_to_call();
+				}
+				else
+				{
+					if (this->depth >= this->max_depth)
+						return new_error("maximum call depth exceeded: " + std::to_string(this->max_depth));
+
+					this->frames.pop_back();
+					this->frames.push_back(Frame{ nullptr, 0, std::move(this->env), callee });
+					this->depth++;
+				}
+
+				this->env = std::move(fn_env);
+				this->push(fn_obj->body);
+				break;
+			}
+			case interp::ast::NodeType::ExpressionStatment:
+			{
+				frame.node = static_cast<interp::ast::ExpressionStatement*>(frame.node)->expression;
+				break;
+			}
+			case interp::ast::NodeType::ForExpression:
+			{
+				// Step 0 evaluates the iterable and 1 enters the loop, keeping
+				// the array and the next index on the values stack. 2 starts an
+				// iteration and from 3 on the body runs, as in a while.
+				auto literal = static_cast<interp::ast::ForExpression*>(frame.node);
+				if (frame.step == 0)
+				{
+					frame.step++;
+					this->push(literal->iterable);
+					break;
+				}
+				if (frame.step == 1)
+				{
+					if (this->values.back().type() != interp::object::ObjectType::ArrayObject)
+						return not_iterable(this->values.back());
+					this->values.push_back(interp::object::Value::integer(0));
+					frame.env = this->env;
+					frame.step = 2;
+				}
+				if (frame.step == 2)
+				{
+					auto index = this->values.back().as_integer();
+					auto array = this->values[this->values.size() - 2].as<interp::object::ArrayObject>();
+					if (static_cast<uint64_t>(index) >= array->length())
+					{
+						this->values.resize(this->values.size() - 2);
+						this->values.push_back(interp::object::Value::null());
+						this->env = std::move(frame.env);
+						this->frames.pop_back();
+						break;
+					}
+
+					if (index == 0 || literal->captures)
+						this->env = interp::object::Environment::new_env(frame.env, literal->locals);
+					this->env->set(literal->variable.slot, array->elements()[index]);
+					this->values.back() = interp::object::Value::integer(index + 1);
+					frame.step = 3;
+				}
+
+				if (this->step_loop_body(frame, literal->body))
+					frame.step = 2;
+				break;
+			}
+			case interp::ast::NodeType::FunctionLiteral:
+			{
+				auto literal = static_cast<interp::ast::FunctionLiteral*>(frame.node);
+				this->values.push_back(interp::object::pool::make<interp::object::FunctionObject>(literal, this->env));
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::HashLiteral:
+			{
+				auto literal = static_cast<interp::ast::HashLiteral*>(frame.node);
+				if (frame.step < literal->pairs.size() * 2)
+				{
+					auto& pair = literal->pairs[frame.step / 2];
+					this->push(frame.step++ % 2 == 0 ? pair.first : pair.second);
+					break;
+				}
+
+				auto first = this->values.size() - literal->pairs.size() * 2;
+				auto result = eval_hash(std::span<const interp::object::Value>(this->values.data() + first, literal->pairs.size() * 2));
+				if (is_error(result))
+					return result;
+				this->values.resize(first);
+				this->values.push_back(std::move(result));
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::Identifier:
+			{
+				auto literal = static_cast<interp::ast::Identifier*>(frame.node);
+				auto& value = this->env->get(literal->depth, literal->slot);
+				if (!value)
+					return new_error("identifier not found: " + literal->value);
+
+				this->values.push_back(value);
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::IfExpression:
+			{
+				auto literal = static_cast<interp::ast::IfExpression*>(frame.node);
+				if (frame.step == 0)
+				{
+					frame.step++;
+					this->push(literal->condition);
+					break;
+				}
+
+				bool truthy = is_truthy(this->values.back());
+				this->values.pop_back();
+
+				// The chosen branch replaces the if
+				auto branch = truthy ? literal->consequence : literal->alternative;
+				if (branch)
+				{
+					frame.node = branch;
+					frame.step = 0;
+				}
+				else
+				{
+					this->values.push_back(interp::object::Value::null());
+					this->frames.pop_back();
+				}
+				break;
+			}
+			case interp::ast::NodeType::IndexExpression:
+			{
+				auto literal = static_cast<interp::ast::IndexExpression*>(frame.node);
+				if (frame.step < 2)
+				{
+					this->push(frame.step++ == 0 ? literal->left : literal->index);
+					break;
+				}
+
+				auto result = eval_index(this->values[this->values.size() - 2], this->values.back());
+				if (is_error(result))
+					return result;
+				this->values.pop_back();
+				this->values.back() = std::move(result);
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::InfixExpression:
+			{
+				auto literal = static_cast<interp::ast::InfixExpression*>(frame.node);
+				if (frame.step < 2)
+				{
+					this->push(frame.step++ == 0 ? literal->left : literal->right);
+					break;
+				}
+
+				auto result = eval_infix(literal->op, this->values[this->values.size() - 2], this->values.back());
+				if (is_error(result))
+					return result;
+				this->values.pop_back();
+				this->values.back() = std::move(result);
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::IntegerLiteral:
+			{
+				auto literal = static_cast<interp::ast::IntegerLiteral*>(frame.node);
+				this->values.push_back(interp::object::Value::integer(literal->value));
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::LetStatment:
+			{
+				auto literal = static_cast<interp::ast::LetStatement*>(frame.node);
+				if (frame.step == 0)
+				{
+					frame.step++;
+					this->push(literal->value);
+					break;
+				}
+
+				this->env->set(literal->name.slot, this->values.back());
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::PrefixExpression:
+			{
+				auto literal = static_cast<interp::ast::PrefixExpression*>(frame.node);
+				if (frame.step == 0)
+				{
+					frame.step++;
+					this->push(literal->right);
+					break;
+				}
+
+				auto result = eval_prefix(literal->op, this->values.back());
+				if (is_error(result))
+					return result;
+				this->values.back() = std::move(result);
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::ReturnStatment:
+			{
+				auto literal = static_cast<interp::ast::ReturnStatement*>(frame.node);
+				if (frame.step == 0)
+				{
+					frame.step++;
+					this->push(literal->return_value);
+					break;
+				}
+
+				auto result = std::move(this->values.back());
+				if (this->depth == 0)
+					return result;
+
+				this->unwind_to_call();
+				this->values.push_back(std::move(result));
+				break;
+			}
+			case interp::ast::NodeType::StringLiteral:
+			{
+				auto literal = static_cast<interp::ast::StringLiteral*>(frame.node);
+				this->values.push_back(literal->cached
+					? literal->cached
+					: interp::object::nursery::make<interp::object::StringObject>(literal->value));
+				this->frames.pop_back();
+				break;
+			}
+			case interp::ast::NodeType::WhileExpression:
+			{
+				// Step 0 enters the loop, 1 starts an iteration, 2 tests the
+				// condition and from 3 on the body runs. The loop's environment
+				// replaces env meanwhile, frame.env keeps the outer one.
+				auto literal = static_cast<interp::ast::WhileExpression*>(frame.node);
+				if (frame.step < 2)
+				{
+					if (frame.step == 0)
+						frame.env = this->env;
+					if (frame.step == 0 || literal->captures)
+						this->env = interp::object::Environment::new_env(frame.env, literal->locals);
+					frame.step = 2;
+					this->push(literal->condition);
+					break;
+				}
+				if (frame.step == 2)
+				{
+					bool truthy = is_truthy(this->values.back());
+					this->values.pop_back();
+					if (!truthy)
+					{
+						this->values.push_back(interp::object::Value::null());
+						this->env = std::move(frame.env);
+						this->frames.pop_back();
+						break;
+					}
+					frame.step = 3;
+				}
+
+				if (this->step_loop_body(frame, literal->body))
+					frame.step = 1;
+				break;
+			}
+			default:
+				return new_error("cannot evaluate " + interp::ast::node_type_to_string(frame.node->type()));
+			}
+		}
+
+		return std::move(this->values.back());
+	}
+
+	void StackEvaluator::push(interp::ast::Node* node)
+	{
+		this->frames.push_back(Frame{ node, 0, nullptr, 0 });
+	}
+
+	// Pushes the next statement of a loop's body, its index being step - 3,
+	// dropping the value of the one before. Returns true once the body is done.
+	bool StackEvaluator::step_loop_body(Frame& frame, interp::ast::BlockExpression* body)
+	{
+		auto index = frame.step - 3;
+		if (index > 0)
+			this->values.pop_back();
+		if (index < body->statements.size())
+		{
+			frame.step++;
+			this->push(body->statements[index]);
+			return false;
+		}
+		return true;
+	}
+
+	// Drops every frame and value above the innermost call boundary.
+	void StackEvaluator::unwind_to_call()
+	{
+		while (this->frames.back().node)
+		{
+			this->frames.pop_back();
+		}
+		this->values.resize(this->frames.back().height);
+	}
+
+	interp::object::Value eval_on_heap(interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env)
+	{
+		return StackEvaluator().run(program, env);
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ast.h"
+#include "object.h"
+
+namespace interp::eval
+{
+	constexpr size_t DEFAULT_MAX_DEPTH = 100000;
+
+	// Walks the AST like eval, but keeps its continuations in frames on a
+	// heap stack instead of recursing, so scripts cannot exhaust the native
+	// stack. Recursing deeper than max_depth calls is an error.
+	class StackEvaluator
+	{
+	public:
+		StackEvaluator(size_t max_depth = DEFAULT_MAX_DEPTH);
+		~StackEvaluator() = default;
+
+		// Resolves program and evaluates it in env, its global environment.
+		interp::object::Value run(interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env);
+
+	private:
+		// A node being evaluated, step counting the parts of it already done.
+		// A frame without a node marks a function call: it restores env to
+		// the caller's once the body's value is on the stack.
+		struct Frame
+		{
+			interp::ast::Node* node;
+			uint32_t step;
+			interp::object::Ref<interp::object::Environment> env;
+			size_t height;
+		};
+
+		size_t max_depth;
+		size_t depth = 0;
+		std::vector<Frame> frames;
+		std::vector<interp::object::Value> values;
+		interp::object::Ref<interp::object::Environment> env;
+
+		void push(interp::ast::Node* node);
+		bool step_loop_body(Frame& frame, interp::ast::BlockExpression* body);
+		void unwind_to_call();
+	};
+
+	interp::object::Value eval_on_heap(interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env);
+}
@@ -0,0 +1,255 @@
+#include "vm.h"
+#include "eval.h"
+#include "folder.h"
+#include "resolver.h"
+#include "compiler/compiler.h"
+
+namespace interp::vm
+{
+	interp::object::Value VM::run(std::shared_ptr<const interp::compiler::FunctionProto> script, interp::object::Ref<interp::object::Environment> env)
+	{
+		using interp::compiler::OpCode;
+		using interp::compiler::read_operand;
+
+		if (script->chunk.code.empty())
+			return interp::object::Value();
+
+		this->stack.clear();
+		this->frames.clear();
+
+		auto proto = std::move(script);
+		const uint8_t* ip = proto->chunk.code.data();
+		size_t base = 0;
+
+		while (true)
+		{
+			auto op = static_cast<OpCode>(*ip++);
+			switch (op)
+			{
+			case OpCode::Constant:
+				this->stack.push_back(proto->chunk.constants[read_operand(ip)]);
+				break;
+			case OpCode::SmallInt:
+				this->stack.push_back(interp::object::Value::integer(static_cast<int32_t>(read_operand(ip))));
+				break;
+			case OpCode::True:
+				this->stack.push_back(interp::object::Value::boolean(true));
+				break;
+			case OpCode::False:
+				this->stack.push_back(interp::object::Value::boolean(false));
+				break;
+			case OpCode::Null:
+				this->stack.push_back(interp::object::Value::null());
+				break;
+			case OpCode::Pop:
+				this->stack.pop_back();
+				break;
+			case OpCode::GetVar:
+			{
+				auto depth = read_operand(ip);
+				auto slot = read_operand(ip);
+				auto name = read_operand(ip);
+
+				auto& value = env->get(depth, slot);
+				if (!value)
+					return interp::eval::new_error("identifier not found: " + proto->chunk.names[name].str());
+				this->stack.push_back(value);
+				break;
+			}
+			case OpCode::SetVar:
+				env->set(read_operand(ip), this->stack.back());
+				break;
+			case OpCode::Assign:
+			{
+				auto depth = read_operand(ip);
+				auto slot = read_operand(ip);
+				auto name = read_operand(ip);
+
+				if (!env->assign(depth, slot, this->stack.back()))
+					return interp::eval::new_error("identifier not found: " + proto->chunk.names[name].str());
+				break;
+			}
+			case OpCode::Prefix:
+			{
+				auto prefix_op = static_cast<interp::ast::Operator>(read_operand(ip));
+				auto result = interp::eval::eval_prefix(prefix_op, this->stack.back());
+				if (interp::eval::is_error(result))
+					return result;
+				this->stack.back() = std::move(result);
+				break;
+			}
+			case OpCode::Infix:
+			{
+				auto infix_op = static_cast<interp::ast::Operator>(read_operand(ip));
+				auto result = interp::eval::eval_infix(infix_op, this->stack[this->stack.size() - 2], this->stack.back());
+				if (interp::eval::is_error(result))
+					return result;
+				this->stack.pop_back();
+				this->stack.back() = std::move(result);
+				break;
+			}
+			case OpCode::Array:
+			{
+				auto count = read_operand(ip);
+				auto first = this->stack.end() - count;
+				std::vector<interp::object::Value> elements(std::make_move_iterator(first), std::make_move_iterator(this->stack.end()));
+				this->stack.erase(first, this->stack.end());
+				this->stack.push_back(interp::object::pool::make<interp::object::ArrayObject>(std::move(elements)));
+				break;
+			}
+			case OpCode::Hash:
+			{
+				auto count = read_operand(ip);
+				auto first = this->stack.size() - count;
+				auto result = interp::eval::eval_hash(std::span<const interp::object::Value>(this->stack.data() + first, count));
+				if (interp::eval::is_error(result))
+					return result;
+				this->stack.resize(first);
+				this->stack.push_back(std::move(result));
+				break;
+			}
+			case OpCode::Index:
+			{
+				auto result = interp::eval::eval_index(this->stack[this->stack.size() - 2], this->stack.back());
+				if (interp::eval::is_error(result))
+					return result;
+				this->stack.pop_back();
+				this->stack.back() = std::move(result);
+				break;
+			}
+			case OpCode::Jump:
+				ip = proto->chunk.code.data() + read_operand(ip);
+				break;
+			case OpCode::JumpIfFalse:
+			{
+				auto target = read_operand(ip);
+				if (!interp::eval::is_truthy(this->stack.back()))
+					ip = proto->chunk.code.data() + target;
+				this->stack.pop_back();
+				break;
+			}
+			case OpCode::ForNext:
+			{
+				auto target = read_operand(ip);
+				auto& iterable = this->stack[this->stack.size() - 2];
+				if (iterable.type() != interp::object::ObjectType::ArrayObject)
+					return interp::eval::not_iterable(iterable);
+
+				auto array = iterable.as<interp::object::ArrayObject>();
+				auto index = this->stack.back().as_integer();
+				if (static_cast<uint64_t>(index) >= array->length())
+				{
+					this->stack.resize(this->stack.size() - 2);
+					ip = proto->chunk.code.data() + target;
+					break;
+				}
+
+				this->stack.back() = interp::object::Value::integer(index + 1);
+				this->stack.push_back(array->elements()[index]);
+				break;
+			}
+			case OpCode::PushEnv:
+				env = interp::object::Environment::new_env(env, read_operand(ip));
+				break;
+			case OpCode::PopEnv:
+				env = env->enclosing();
+				break;
+			case OpCode::Closure:
+			{
+				auto& fn_proto = proto->chunk.functions[read_operand(ip)];
+				this->stack.push_back(interp::object::pool::make<interp::object::FunctionObject>(fn_proto->literal, env, fn_proto));
+				break;
+			}
+			case OpCode::Call:
+			case OpCode::TailCall:
+			{
+				auto argc = read_operand(ip);
+				auto callee = this->stack.size() - argc - 1;
+				auto& fn = this->stack[callee];
+
+				// Natives read their arguments straight off the stack
+				if (fn.type() == interp::object::ObjectType::BuiltinFnObject)
+				{
+					auto result = fn.as<interp::object::BuiltinFnObject>()->value(
+						std::span<const interp::object::Value>(this->stack.data() + callee + 1, argc));
+					if (interp::eval::is_error(result))
+						return result;
+					this->stack.resize(callee);
+					this->stack.push_back(std::move(result));
+					break;
+				}
+
+				auto fn_obj = fn.type() == interp::object::ObjectType::FunctionObject
+					? fn.as<interp::object::FunctionObject>()
+					: nullptr;
+
+				// Anything without bytecode, such as functions made by the
+				// tree walker, goes through its apply_fn. For a tail call the
+				// Return that follows hands the result on.
+				if (!fn_obj || !fn_obj->proto)
+				{
+					std::vector<interp::object::Value> args(
+						std::make_move_iterator(this->stack.begin() + callee + 1),
+						std::make_move_iterator(this->stack.end()));
+					auto result = interp::eval::apply_fn(fn, args);
+					if (interp::eval::is_error(result))
+						return result;
+					this->stack.resize(callee);
+					this->stack.push_back(std::move(result));
+					break;
+				}
+
+				auto fn_env = interp::object::Environment::new_env(fn_obj->environment, fn_obj->locals);
+				for (size_t i = 0; i < fn_obj->params.size() && i < argc; i++)
+				{
+					fn_env->set(fn_obj->params[i]->slot, std::move(this->stack[callee + 1 + i]));
+				}
+
+				if (op == OpCode::Call)
+				{
+					this->frames.push_back(Frame{ std::move(proto), ip, std::move(env), base });
+					proto = fn_obj->proto;
+					this->stack.resize(callee);
+					base = callee;
+				}
+				else
+				{
+					// The caller's frame is done with, the callee takes it over
+					proto = fn_obj->proto;
+					this->stack.resize(base);
+				}
+				ip = proto->chunk.code.data();
+				env = std::move(fn_env);
+				break;
+			}
+			case OpCode::Return:
+			{
+				auto result = std::move(this->stack.back());
+				if (this->frames.empty())
+					return result;
+
+				this->stack.resize(base);
+				this->stack.push_back(std::move(result));
+
+				auto& frame = this->frames.back();
+				proto = std::move(frame.proto);
+				ip = frame.ip;
+				env = std::move(frame.env);
+				base = frame.base;
+				this->frames.pop_back();
+				break;
+			}
+			default:
+				return interp::eval::new_error("invalid instruction: " + interp::compiler::opcode_to_string(op));
+			}
+		}
+	}
+
+	interp::object::Value run(interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env)
+	{
+		interp::parser::Folder(*program->arena).fold(program);
+		interp::parser::Resolver(*env).resolve(program);
+		auto script = interp::compiler::Compiler().compile(program);
+		return VM().run(script, env);
+	}
+}
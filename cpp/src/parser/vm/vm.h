@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ast.h"
+#include "object.h"
+#include "compiler/code.h"
+
+namespace interp::vm
+{
+	// Stack machine running compiled programs. Calls push frames on the heap
+	// instead of recursing, variables live in the same environments the tree
+	// walker uses and operators share its dispatch tables, so both engines
+	// produce the same results.
+	class VM
+	{
+	public:
+		VM() = default;
+		~VM() = default;
+
+		// Runs a compiled program in env, its global environment.
+		interp::object::Value run(std::shared_ptr<const interp::compiler::FunctionProto> script, interp::object::Ref<interp::object::Environment> env);
+
+	private:
+		struct Frame
+		{
+			std::shared_ptr<const interp::compiler::FunctionProto> proto;
+			const uint8_t* ip;
+			interp::object::Ref<interp::object::Environment> env;
+			size_t base;
+		};
+
+		std::vector<interp::object::Value> stack;
+		std::vector<Frame> frames;
+	};
+
+	// Resolves and compiles program, then runs it in env. The counterpart of
+	// interp::eval::eval for a whole program.
+	interp::object::Value run(interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env);
+}
@@ -0,0 +1,34 @@
+#include "engine.h"
+#include "parser/eval.h"
+#include "parser/stack_eval.h"
+#include "parser/vm/vm.h"
+
+namespace interp::repl
+{
+	bool engine_from_string(const std::string& name, Engine& engine)
+	{
+		if (name == "tree")
+			engine = Engine::Tree;
+		else if (name == "vm")
+			engine = Engine::Bytecode;
+		else if (name == "stack")
+			engine = Engine::Stack;
+		else
+			return false;
+
+		return true;
+	}
+
+	interp::object::Value evaluate(Engine engine, interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env)
+	{
+		switch (engine)
+		{
+		case Engine::Bytecode:
+			return interp::vm::run(program, env);
+		case Engine::Stack:
+			return interp::eval::eval_on_heap(program, env);
+		default:
+			return interp::eval::eval(program, env);
+		}
+	}
+}
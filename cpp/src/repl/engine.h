@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "parser/ast.h"
+#include "parser/object.h"
+
+namespace interp::repl
+{
+	// Ways of executing a parsed program
+	enum struct Engine
+	{
+		Tree,	  // interp::eval, walking the AST
+		Bytecode, // interp::vm, compiling to bytecode first
+		Stack,	  // interp::eval::StackEvaluator, walking the AST without recursing
+	};
+
+	// Parses the value of --engine, returns false if name is not an engine.
+	bool engine_from_string(const std::string& name, Engine& engine);
+
+	interp::object::Value evaluate(Engine engine, interp::ast::Program* program, interp::object::Ref<interp::object::Environment>& env);
+}
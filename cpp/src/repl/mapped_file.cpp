@@ -0,0 +1,130 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace interp::repl
+{
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::string& path)
+		: data(nullptr), size(0), file(INVALID_HANDLE_VALUE), mapping(nullptr)
+	{
+		this->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (this->file == INVALID_HANDLE_VALUE)
+		{
+			this->error_message = "could not open " + path + " (error " + std::to_string(GetLastError()) + ")";
+			return;
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(this->file, &file_size))
+		{
+			this->error_message = "could not read size of " + path + " (error " + std::to_string(GetLastError()) + ")";
+			return;
+		}
+
+		// Empty files cannot be mapped, they are simply an empty view
+		if (file_size.QuadPart == 0)
+			return;
+
+		this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!this->mapping)
+		{
+			this->error_message = "could not map " + path + " (error " + std::to_string(GetLastError()) + ")";
+			return;
+		}
+
+		this->data = static_cast<const char*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!this->data)
+		{
+			this->error_message = "could not map " + path + " (error " + std::to_string(GetLastError()) + ")";
+			return;
+		}
+		this->size = static_cast<size_t>(file_size.QuadPart);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (this->data)
+			UnmapViewOfFile(this->data);
+		if (this->mapping)
+			CloseHandle(this->mapping);
+		if (this->file != INVALID_HANDLE_VALUE)
+			CloseHandle(this->file);
+	}
+#else
+	MappedFile::MappedFile(const std::string& path)
+		: data(nullptr), size(0), fd(-1)
+	{
+		this->fd = open(path.c_str(), O_RDONLY);
+		if (this->fd < 0)
+		{
+			this->error_message = "could not open " + path + ": " + std::strerror(errno);
+			return;
+		}
+
+		struct stat info;
+		if (fstat(this->fd, &info) != 0)
+		{
+			this->error_message = "could not stat " + path + ": " + std::strerror(errno);
+			return;
+		}
+
+		if (!S_ISREG(info.st_mode))
+		{
+			this->error_message = path + " is not a regular file";
+			return;
+		}
+
+		// Empty files cannot be mapped, they are simply an empty view
+		if (info.st_size == 0)
+			return;
+
+		auto mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			this->error_message = "could not map " + path + ": " + std::strerror(errno);
+			return;
+		}
+
+		// Scripts are lexed front to back exactly once
+		madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+
+		this->data = static_cast<const char*>(mapped);
+		this->size = static_cast<size_t>(info.st_size);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (this->data)
+			munmap(const_cast<char*>(this->data), this->size);
+		if (this->fd >= 0)
+			close(this->fd);
+	}
+#endif
+
+	bool MappedFile::is_open() const
+	{
+		return this->error_message.empty();
+	}
+
+	const std::string& MappedFile::error() const
+	{
+		return this->error_message;
+	}
+
+	std::string_view MappedFile::view() const
+	{
+		return std::string_view(this->data, this->size);
+	}
+}
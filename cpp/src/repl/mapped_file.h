@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace interp::repl
+{
+	// Read-only memory mapping of a whole file.
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool is_open() const;
+		// Why the file could not be mapped, empty when is_open()
+		const std::string& error() const;
+		std::string_view view() const;
+
+	private:
+		const char* data;
+		size_t size;
+		std::string error_message;
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#else
+		int fd;
+#endif
+	};
+}
@@ -9,7 +9,7 @@
 
 namespace interp::repl
 {
-	void start()
+	void start(Engine engine)
 	{
 
 		auto env = interp::object::Environment::new_env(nullptr);
@@ -20,7 +20,7 @@ namespace interp::repl
 			std::cout << ">> ";
 			std::getline(std::cin, input);
 
-			interp::lexer::Lexer lex(input);
+			auto lex = interp::lexer::Lexer::borrow(input);
 			interp::parser::Parser parse(lex);
 
 			auto prog = parse.parse_program();
@@ -36,10 +36,10 @@ namespace interp::repl
 				continue;
 			}
 
-			auto evaluated = interp::eval::eval(prog, env);
+			auto evaluated = evaluate(engine, prog.get(), env);
 			if (evaluated)
 			{
-				std::cout << evaluated->inspect() << '\n';
+				std::cout << evaluated.inspect() << '\n';
 			}
 
 			input.clear();
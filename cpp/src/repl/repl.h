@@ -1,6 +1,20 @@
 #pragma once
 
+#include <string>
+
+#include "engine.h"
+
 namespace interp::repl
 {
-	void start();
+	// Exit statuses of run_file
+	constexpr int EXIT_OK = 0;
+	constexpr int EXIT_SCRIPT_ERROR = 1;
+	constexpr int EXIT_IO_ERROR = 2;
+
+	void start(Engine engine = Engine::Tree);
+
+	// Parses and evaluates the script at path in a fresh environment, reading
+	// it straight out of a read-only mapping. Prints the result of the last
+	// statement unless it is null and returns one of the exit statuses above.
+	int run_file(const std::string& path, Engine engine = Engine::Tree);
 }
@@ -0,0 +1,64 @@
+#include <exception>
+#include <iostream>
+
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+#include "parser/eval.h"
+#include "mapped_file.h"
+#include "repl.h"
+
+namespace interp::repl
+{
+	int run_file(const std::string& path, Engine engine)
+	{
+		MappedFile file(path);
+		if (!file.is_open())
+		{
+			std::cerr << file.error() << '\n';
+			return EXIT_IO_ERROR;
+		}
+
+		try
+		{
+			auto lex = interp::lexer::Lexer::borrow(file.view());
+			interp::parser::Parser parse(lex);
+
+			auto prog = parse.parse_program();
+			auto errors = parse.get_errors();
+
+			if (errors.size() > 0)
+			{
+				for (auto& error : errors)
+				{
+					std::cerr << path << ": " << error << '\n';
+				}
+				return EXIT_SCRIPT_ERROR;
+			}
+
+			auto env = interp::object::Environment::new_env(nullptr);
+			auto evaluated = evaluate(engine, prog.get(), env);
+			if (!evaluated)
+			{
+				return EXIT_OK;
+			}
+
+			if (evaluated.type() == interp::object::ObjectType::ErrorObject)
+			{
+				std::cerr << path << ": " << evaluated.inspect() << '\n';
+				return EXIT_SCRIPT_ERROR;
+			}
+
+			if (evaluated.type() != interp::object::ObjectType::NullObject)
+			{
+				std::cout << evaluated.inspect() << '\n';
+			}
+
+			return EXIT_OK;
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << path << ": " << e.what() << '\n';
+			return EXIT_SCRIPT_ERROR;
+		}
+	}
+}
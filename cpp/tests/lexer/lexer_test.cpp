@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "lexer.h"
 #include "token.h"
+#include "scan.h"
+#include "atom.h"
 
 // Demonstrate some basic assertions.
 TEST(LexerTest, TestNextToken)
@@ -24,6 +26,9 @@ return false;
 >=
 "foobar"
 "foo bar"
+[1, 2];
+{"foo": "bar"}
+while for in
 )";
 
 
@@ -105,6 +110,20 @@ return false;
 		std::pair(interp::token::GREATERTHANOREQUAL, ">="),
 		std::pair(interp::token::STRING, "foobar"),
 		std::pair(interp::token::STRING, "foo bar"),
+		std::pair(interp::token::LBRACKET, "["),
+		std::pair(interp::token::INT, "1"),
+		std::pair(interp::token::COMMA, ","),
+		std::pair(interp::token::INT, "2"),
+		std::pair(interp::token::RBRACKET, "]"),
+		std::pair(interp::token::SEMICOLON, ";"),
+		std::pair(interp::token::LBRACE, "{"),
+		std::pair(interp::token::STRING, "foo"),
+		std::pair(interp::token::COLON, ":"),
+		std::pair(interp::token::STRING, "bar"),
+		std::pair(interp::token::RBRACE, "}"),
+		std::pair(interp::token::WHILE, "while"),
+		std::pair(interp::token::FOR, "for"),
+		std::pair(interp::token::IN, "in"),
 		std::pair(interp::token::L_EOF, ""),
 	};
 
@@ -125,4 +144,117 @@ return false;
 	// EXPECT_STRNE("hello", "world");
 	// // Expect equality.
 	// EXPECT_EQ(7 * 6, 42);
-}
\ No newline at end of file
+}
+
+TEST(LexerTest, TestSpanTokens)
+{
+	std::string input = R"(let name = "foo bar";
+add(name, 12345) >= 10)";
+
+	struct Expected
+	{
+		interp::token::TokenType type;
+		uint32_t offset;
+		std::string literal;
+	};
+
+	Expected expected[] = {
+		{interp::token::LET, 0, "let"},
+		{interp::token::IDENT, 4, "name"},
+		{interp::token::ASSIGN, 9, "="},
+		{interp::token::STRING, 12, "foo bar"},
+		{interp::token::SEMICOLON, 20, ";"},
+		{interp::token::IDENT, 22, "add"},
+		{interp::token::LPAREN, 25, "("},
+		{interp::token::IDENT, 26, "name"},
+		{interp::token::COMMA, 30, ","},
+		{interp::token::INT, 32, "12345"},
+		{interp::token::RPAREN, 37, ")"},
+		{interp::token::GREATERTHANOREQUAL, 39, ">="},
+		{interp::token::INT, 42, "10"},
+		{interp::token::L_EOF, 44, ""},
+		{interp::token::L_EOF, 44, ""},
+	};
+
+	auto lex = interp::lexer::Lexer::borrow(input);
+
+	for (auto& tt : expected)
+	{
+		auto tok = lex.next_span_token();
+
+		EXPECT_EQ(tt.type, tok.type);
+		EXPECT_EQ(tt.offset, tok.span.offset) << "wrong offset for " << tt.literal;
+		EXPECT_EQ(tt.literal, lex.text(tok.span));
+		EXPECT_EQ(tt.literal, lex.materialize(tok).literal);
+	}
+}
+
+TEST(LexerTest, TestScannersAgree)
+{
+	using interp::lexer::scan::Isa;
+
+	struct Scanner
+	{
+		const char* name;
+		const char* (*skip)(const char*, const char*);
+		char inside;
+		char stop;
+	};
+
+	Scanner scanners[] = {
+		{"whitespace", interp::lexer::scan::skip_whitespace, '\t', 'x'},
+		{"letters", interp::lexer::scan::skip_letters, '_', '9'},
+		{"digits", interp::lexer::scan::skip_digits, '7', 'a'},
+		{"string body", interp::lexer::scan::skip_string_body, ' ', '"'},
+		{"string body", interp::lexer::scan::skip_string_body, 'x', '\0'},
+	};
+
+	auto initial = interp::lexer::scan::active_isa();
+
+	for (auto isa : {Isa::Scalar, Isa::SSE2, Isa::AVX2})
+	{
+		if (!interp::lexer::scan::set_isa(isa))
+			continue;
+
+		for (auto& scanner : scanners)
+		{
+			// Runs of every length up to a few blocks, so the stop character
+			// lands in every lane and in the scalar tail
+			for (size_t length = 0; length < 100; length++)
+			{
+				std::string input(length, scanner.inside);
+				input += scanner.stop;
+				input += std::string(40, scanner.inside);
+
+				auto begin = input.data();
+				EXPECT_EQ(length, scanner.skip(begin, begin + input.size()) - begin)
+					<< scanner.name << " with " << interp::lexer::scan::isa_to_string(isa);
+				EXPECT_EQ(length, scanner.skip(begin, begin + length) - begin)
+					<< scanner.name << " to end with " << interp::lexer::scan::isa_to_string(isa);
+			}
+		}
+
+		std::string mixed = "  \n\t\r  \n        \t\t\t\t\r\n               \v";
+		EXPECT_EQ(mixed.size() - 1, interp::lexer::scan::skip_whitespace(mixed.data(), mixed.data() + mixed.size()) - mixed.data());
+
+		std::string ident = "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ@";
+		EXPECT_EQ(ident.size() - 1, interp::lexer::scan::skip_letters(ident.data(), ident.data() + ident.size()) - ident.data());
+
+		std::string high = "abcdefghijklmnopqrstuvwxyz\xe1";
+		EXPECT_EQ(high.size() - 1, interp::lexer::scan::skip_letters(high.data(), high.data() + high.size()) - high.data());
+	}
+
+	interp::lexer::scan::set_isa(initial);
+}
+TEST(LexerTest, TestAtoms)
+{
+	std::string owned = "counter";
+	auto first = interp::lexer::intern("counter");
+	auto second = interp::lexer::intern(owned);
+
+	EXPECT_TRUE(first == second) << "same text should give the same atom";
+	EXPECT_EQ(&first.str(), &second.str());
+	EXPECT_EQ("counter", first.str());
+	EXPECT_FALSE(first == interp::lexer::intern("count"));
+	EXPECT_TRUE(interp::lexer::Atom() == interp::lexer::intern(""));
+}
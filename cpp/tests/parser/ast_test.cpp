@@ -5,14 +5,13 @@
 
 TEST(AstTest, TestString)
 {
-	interp::ast::Program prog = interp::ast::Program(std::vector({ 
-		std::shared_ptr<interp::ast::Statement>(new interp::ast::LetStatement(
-			{.type = interp::token::LET, .literal = "let"},
+	auto arena = std::make_shared<interp::ast::AstArena>();
+	interp::ast::Program prog = interp::ast::Program(arena, std::vector<interp::ast::Statement*>({
+		arena->make<interp::ast::LetStatement>(
+			interp::token::Token{.type = interp::token::LET, .literal = "let"},
 			interp::ast::Identifier({.type = interp::token::IDENT, .literal = "myVar"}, "myVar"),
-			std::shared_ptr<interp::ast::Expression>(
-				new interp::ast::Identifier({.type = interp::token::IDENT, .literal = "anotherVar"}, "anotherVar")
-			)
-		))
+			arena->make<interp::ast::Identifier>(interp::token::Token{.type = interp::token::IDENT, .literal = "anotherVar"}, "anotherVar")
+		)
 	}));
 	EXPECT_EQ("let myVar = anotherVar;", prog.string());
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "parser.h"
+#include "resolver.h"
+#include "compiler/compiler.h"
+
+std::shared_ptr<const interp::compiler::FunctionProto> test_compile(std::shared_ptr<interp::ast::Program>& prog, std::string input);
+
+TEST(CompilerTest, TestCompileProgram)
+{
+	std::pair<std::string, std::string> expected[] = {
+		std::pair("", ""),
+		std::pair("1 + 2",
+			"0 SMALL_INT 1\n"
+			"5 SMALL_INT 2\n"
+			"10 INFIX 0\n"
+			"15 RETURN\n"),
+		// Only integers outside the small range take a constant
+		std::pair("1024 * 1025",
+			"0 SMALL_INT 1024\n"
+			"5 CONSTANT 0\n"
+			"10 INFIX 2\n"
+			"15 RETURN\n"),
+		std::pair("let x = 1; -x",
+			"0 SMALL_INT 1\n"
+			"5 SET_VAR 0\n"
+			"10 POP\n"
+			"11 GET_VAR 0 0 0\n"
+			"24 PREFIX 1\n"
+			"29 RETURN\n"),
+		// Blocks only enter an environment for variables that would be globals
+		std::pair("if (true) { 1 } else { 2 }",
+			"0 TRUE\n"
+			"1 JUMP_IF_FALSE 16\n"
+			"6 SMALL_INT 1\n"
+			"11 JUMP 21\n"
+			"16 SMALL_INT 2\n"
+			"21 RETURN\n"),
+		std::pair("{ let x = 1 }",
+			"0 PUSH_ENV 1\n"
+			"5 SMALL_INT 1\n"
+			"10 SET_VAR 0\n"
+			"15 POP_ENV\n"
+			"16 RETURN\n"),
+		std::pair("[1, 2][0]",
+			"0 SMALL_INT 1\n"
+			"5 SMALL_INT 2\n"
+			"10 ARRAY 2\n"
+			"15 SMALL_INT 0\n"
+			"20 INDEX\n"
+			"21 RETURN\n"),
+		std::pair("{1: true}",
+			"0 SMALL_INT 1\n"
+			"5 TRUE\n"
+			"6 HASH 2\n"
+			"11 RETURN\n"),
+		// The loop's environment is entered once, not per iteration, and
+		// every use of i shares one name
+		std::pair("let i = 0; while (i < 1) { i = i + 1 }",
+			"0 SMALL_INT 0\n"
+			"5 SET_VAR 0\n"
+			"10 POP\n"
+			"11 PUSH_ENV 0\n"
+			"16 GET_VAR 1 0 0\n"
+			"29 SMALL_INT 1\n"
+			"34 INFIX 7\n"
+			"39 JUMP_IF_FALSE 86\n"
+			"44 GET_VAR 1 0 0\n"
+			"57 SMALL_INT 1\n"
+			"62 INFIX 0\n"
+			"67 ASSIGN 1 0 0\n"
+			"80 POP\n"
+			"81 JUMP 16\n"
+			"86 POP_ENV\n"
+			"87 NULL\n"
+			"88 RETURN\n"),
+	};
+
+	for (auto& tt : expected)
+	{
+		std::shared_ptr<interp::ast::Program> prog;
+		auto script = test_compile(prog, tt.first);
+		EXPECT_EQ(tt.second, interp::compiler::disassemble(script->chunk)) << "Failed for: " << tt.first;
+	}
+}
+
+TEST(CompilerTest, TestCompileFunction)
+{
+	std::shared_ptr<interp::ast::Program> prog;
+	auto script = test_compile(prog, "let add = fn(a, b) { a + b }; add(1, 2)");
+
+	EXPECT_EQ(
+		"0 CLOSURE 0\n"
+		"5 SET_VAR 0\n"
+		"10 POP\n"
+		"11 GET_VAR 0 0 0\n"
+		"24 SMALL_INT 1\n"
+		"29 SMALL_INT 2\n"
+		"34 CALL 2\n"
+		"39 RETURN\n",
+		interp::compiler::disassemble(script->chunk));
+
+	ASSERT_EQ(1, script->chunk.functions.size());
+	EXPECT_EQ(
+		"0 GET_VAR 0 0 0\n"
+		"13 GET_VAR 0 1 1\n"
+		"26 INFIX 0\n"
+		"31 RETURN\n",
+		interp::compiler::disassemble(script->chunk.functions[0]->chunk));
+}
+
+std::shared_ptr<const interp::compiler::FunctionProto> test_compile(std::shared_ptr<interp::ast::Program>& prog, std::string input)
+{
+	interp::lexer::Lexer lex(input);
+	interp::parser::Parser parse(lex);
+	prog = parse.parse_program();
+
+	EXPECT_EQ(0, parse.get_errors().size()) << "Parser errors for: " << input;
+
+	auto env = interp::object::Environment::new_env(nullptr);
+	interp::parser::Resolver(*env).resolve(prog.get());
+	return interp::compiler::Compiler().compile(prog.get());
+}
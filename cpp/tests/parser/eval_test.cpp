@@ -3,13 +3,16 @@
 #include "token.h"
 #include "parser.h"
 #include "eval.h"
+#include "builtins/builtins.h"
+#include "stack_eval.h"
+#include "vm/vm.h"
 
-std::shared_ptr<interp::object::Object> test_eval(std::string input);
-bool test_int_obj(const interp::object::Object* in_object, int64_t expected, std::string input);
-bool test_bool_obj(const interp::object::Object* in_object, bool expected, std::string input);
-bool test_string_obj(const interp::object::Object* in_object, std::string expected, std::string input);
-bool test_null_obj(const interp::object::Object* in_object, std::string input);
-bool test_error(const interp::object::Object* in_object, std::string expected, std::string input);
+interp::object::Value test_eval(std::string input);
+bool test_int_obj(const interp::object::Value& in_object, int64_t expected, std::string input);
+bool test_bool_obj(const interp::object::Value& in_object, bool expected, std::string input);
+bool test_string_obj(const interp::object::Value& in_object, std::string expected, std::string input);
+bool test_null_obj(const interp::object::Value& in_object, std::string input);
+bool test_error(const interp::object::Value& in_object, std::string expected, std::string input);
 
 TEST(EvalTest, TestEvalIntegerExpression)
 {
@@ -29,6 +32,7 @@ TEST(EvalTest, TestEvalIntegerExpression)
 		std::pair("3 * 3 * 3 + 10", 37),
 		std::pair("3 * (3 * 3) + 10", 37),
 		std::pair("(5 + 10 * 2 + 15 / 3) * 2 + -10", 50),
+		std::pair("1024 + 1025 - 5000000000", -4999997951),
 
 		std::pair("return 10;", 10),
 		std::pair("return 10; 9;", 10),
@@ -59,7 +63,7 @@ addTwo(2);
 	for (auto& tt : expected)
 	{
 		auto obj = test_eval(tt.first);
-		test_int_obj(obj.get(), tt.second, tt.first);
+		test_int_obj(obj, tt.second, tt.first);
 	}
 }
 
@@ -83,7 +87,7 @@ TEST(EvalTest, TestEvalBooleanExpression)
 	for (auto& tt : expected)
 	{
 		auto obj = test_eval(tt.first);
-		test_bool_obj(obj.get(), tt.second, tt.first);
+		test_bool_obj(obj, tt.second, tt.first);
 	}
 }
 
@@ -97,10 +101,30 @@ TEST(EvalTest, TestEvalStringExpression)
 	for (auto& tt : expected)
 	{
 		auto obj = test_eval(tt.first);
-		test_string_obj(obj.get(), tt.second, tt.first);
+		test_string_obj(obj, tt.second, tt.first);
 	}
 }
 
+TEST(EvalTest, TestStringBuilding)
+{
+	// Appends far past the rope threshold, then flattens once for inspect
+	auto input = "let build = fn(n, s) { if (n == 0) { s } else { build(n - 1, s + \"0123456789\") } }; build(100000, \"\");";
+
+	std::string expected;
+	for (int i = 0; i < 100000; i++)
+	{
+		expected += "0123456789";
+	}
+
+	test_string_obj(test_eval(input), expected, "build(100000, \"\")");
+
+	auto left = interp::object::make_ref<interp::object::StringObject>(std::string(300, 'a'));
+	auto right = interp::object::make_ref<interp::object::StringObject>("b");
+	auto joined = interp::object::StringObject::concat(left, right);
+	EXPECT_EQ(joined->length(), 301);
+	EXPECT_EQ(joined->value(), std::string(300, 'a') + "b");
+}
+
 TEST(EvalTest, TestBangOperator)
 {
 	std::pair<std::string, bool> expected[] = {
@@ -129,17 +153,17 @@ TEST(EvalTest, TestBangOperator)
 	for (auto& tt : expected)
 	{
 		auto obj = test_eval(tt.first);
-		test_bool_obj(obj.get(), tt.second, tt.first);
+		test_bool_obj(obj, tt.second, tt.first);
 	}
 }
 
 TEST(EvalTest, TestIfElseExpressions)
 {
-	auto NULL_OBJ = std::shared_ptr<interp::object::Null>(new interp::object::Null());
-	auto FIVE_OBJ = std::shared_ptr<interp::object::Integer>(new interp::object::Integer(5));
-	auto FIFTEEN_OBJ = std::shared_ptr<interp::object::Integer>(new interp::object::Integer(15));
+	auto NULL_OBJ = interp::object::Value::null();
+	auto FIVE_OBJ = interp::object::Value::integer(5);
+	auto FIFTEEN_OBJ = interp::object::Value::integer(15);
 
-	std::pair<std::string, std::shared_ptr<interp::object::Object>> expected[] = {
+	std::pair<std::string, interp::object::Value> expected[] = {
 		std::pair("if (true) { 5 }", FIVE_OBJ),
 		std::pair("if (false) { 5 }", NULL_OBJ),
 		std::pair("if (1) { 5 }", FIVE_OBJ),
@@ -153,15 +177,15 @@ TEST(EvalTest, TestIfElseExpressions)
 	{
 		auto obj = test_eval(tt.first);
 
-		switch (tt.second->type())
+		switch (tt.second.type())
 		{
 		case interp::object::ObjectType::IntegerObject:
-			test_int_obj(obj.get(), tt.second == FIVE_OBJ ? 5 : 15, tt.first);
+			test_int_obj(obj, tt.second.as_integer(), tt.first);
 			continue;
 		/*case interp::object::ObjectType::BooleanObject:
 			break;*/
 		case interp::object::ObjectType::NullObject:
-			test_null_obj(obj.get(), tt.first);
+			test_null_obj(obj, tt.first);
 			continue;
 		default:
 			continue;
@@ -181,16 +205,458 @@ TEST(EvalTest, TestErrorHandling)
 		std::pair("if (10 > 1) { if (10 > 1) { return true + false; } return 1; }", "unknown operator: BOOLEAN + BOOLEAN"),
 		std::pair("foobar", "identifier not found: foobar"),
 		std::pair(R"("Hello " - "World!")", "unknown operator: STRING - STRING"),
+		std::pair(R"("a" == "a")", "unknown operator: STRING == STRING"),
+		std::pair("fn(x) { x } < 1", "type mismatch: FunctionObject < INTEGER"),
+		std::pair("10 / (5 - 5)", "division by zero"),
+		std::pair("let m = -9223372036854775807 - 1; m / -1", "integer overflow: -9223372036854775808 / -1"),
+		std::pair("(-9223372036854775807 - 1) / -1", "integer overflow: -9223372036854775808 / -1"),
+		std::pair("let m = 9223372036854775807; m + 1", "integer overflow: 9223372036854775807 + 1"),
+		std::pair("9223372036854775807 + 1", "integer overflow: 9223372036854775807 + 1"),
+		std::pair("let m = -9223372036854775807; m - 2", "integer overflow: -9223372036854775807 - 2"),
+		std::pair("let m = 4294967296; m * m", "integer overflow: 4294967296 * 4294967296"),
+		std::pair("let m = -9223372036854775807 - 1; -m", "integer overflow: -(-9223372036854775808)"),
+		std::pair("-(-9223372036854775807 - 1)", "integer overflow: -(-9223372036854775808)"),
+	};
+
+	for (auto& tt : expected)
+	{
+		auto obj = test_eval(tt.first);
+		test_error(obj, tt.second, tt.first);
+	}
+}
+
+TEST(EvalTest, TestBuiltinFunctions)
+{
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair(R"(len(""))", 0),
+		std::pair(R"(len("four"))", 4),
+		std::pair(R"(len("hello" + " world"))", 11),
+		// Through a tail call, and shadowed by a declaration
+		std::pair(R"(let count = fn(s) { len(s) }; count("abc"))", 3),
+		std::pair(R"(let len = fn(s) { 42 }; len("abc"))", 42),
+	};
+
+	for (auto& tt : expected)
+	{
+		test_int_obj(test_eval(tt.first), tt.second, tt.first);
+	}
+
+	test_error(test_eval("len(1)"), "argument to `len` not supported, got=INTEGER", "len(1)");
+	test_error(test_eval(R"(len("one", "two"))"), "wrong number of arguments. got=2 want=1", "len(\"one\", \"two\")");
+}
+
+TEST(EvalTest, TestRegisterBuiltin)
+{
+	interp::eval::register_builtin("sum", [](std::span<const interp::object::Value> args)
+	{
+		int64_t total = 0;
+		for (auto& arg : args)
+		{
+			total += arg.as_integer();
+		}
+		return interp::object::Value::integer(total);
+	});
+
+	test_int_obj(test_eval("sum(1, 2, 3) + sum()"), 6, "sum(1, 2, 3) + sum()");
+	test_int_obj(test_eval("let f = fn() { sum(4, 5) }; f()"), 9, "f()");
+}
+
+TEST(EvalTest, TestArrayLiterals)
+{
+	std::pair<std::string, std::string> expected[] = {
+		std::pair("[]", "[]"),
+		std::pair("[1, 2 * 2, 3 + 3]", "[1, 4, 6]"),
+		std::pair(R"([1, "two", [true, fn(x) { x }(3)]])", "[1, two, [true, 3]]"),
+	};
+
+	for (auto& tt : expected)
+	{
+		auto evaluated = test_eval(tt.first);
+		ASSERT_EQ(interp::object::ObjectType::ArrayObject, evaluated.type()) << "object is not ArrayObject for: " << tt.first;
+		EXPECT_EQ(tt.second, evaluated.inspect());
+	}
+}
+
+TEST(EvalTest, TestArrayIndexExpressions)
+{
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair("[1, 2, 3][0]", 1),
+		std::pair("[1, 2, 3][1]", 2),
+		std::pair("[1, 2, 3][2]", 3),
+		std::pair("let i = 0; [1][i];", 1),
+		std::pair("[1, 2, 3][1 + 1];", 3),
+		std::pair("let myArray = [1, 2, 3]; myArray[2];", 3),
+		std::pair("let myArray = [1, 2, 3]; myArray[0] + myArray[1] + myArray[2];", 6),
+		std::pair("let myArray = [1, 2, 3]; let i = myArray[0]; myArray[i]", 2),
+		std::pair("[[1, 2], [3, 4]][1][0]", 3),
+	};
+
+	for (auto& tt : expected)
+	{
+		test_int_obj(test_eval(tt.first), tt.second, tt.first);
+	}
+
+	test_null_obj(test_eval("[1, 2, 3][3]"), "[1, 2, 3][3]");
+	test_null_obj(test_eval("[1, 2, 3][-1]"), "[1, 2, 3][-1]");
+	test_error(test_eval("1[0]"), "index operator not supported: INTEGER", "1[0]");
+}
+
+TEST(EvalTest, TestArrayBuiltins)
+{
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair("len([1, 2, 3])", 3),
+		std::pair("len([])", 0),
+		std::pair("first([1, 2, 3])", 1),
+		std::pair("last([1, 2, 3])", 3),
+		std::pair("len(rest([1, 2, 3]))", 2),
+		std::pair("rest([1, 2, 3])[0]", 2),
+		std::pair("rest(rest([1, 2, 3]))[0]", 3),
+		std::pair("last(push([1, 2], 3))", 3),
+		std::pair("let a = [1, 2]; let b = push(a, 3); len(a)", 2),
+	};
+
+	for (auto& tt : expected)
+	{
+		test_int_obj(test_eval(tt.first), tt.second, tt.first);
+	}
+
+	std::pair<std::string, std::string> arrays[] = {
+		std::pair("rest([1])", "[]"),
+		std::pair("push([], 1)", "[1]"),
+		std::pair("push(rest([1, 2]), 3)", "[2, 3]"),
+		// Both pushes see only their own element past the end of a
+		std::pair("let a = [1]; let b = push(a, 2); let c = push(a, 3); [a, b, c]", "[[1], [1, 2], [1, 3]]"),
+		std::pair("let a = push(push([], 1), 2); let b = push(rest(a), 3); [a, b]", "[[1, 2], [2, 3]]"),
+	};
+
+	for (auto& tt : arrays)
+	{
+		EXPECT_EQ(tt.second, test_eval(tt.first).inspect()) << "for: " << tt.first;
+	}
+
+	test_null_obj(test_eval("first([])"), "first([])");
+	test_null_obj(test_eval("last([])"), "last([])");
+	test_null_obj(test_eval("rest([])"), "rest([])");
+	test_error(test_eval("first(1)"), "argument to `first` must be ARRAY, got INTEGER", "first(1)");
+	test_error(test_eval("push([1])"), "wrong number of arguments. got=1 want=2", "push([1])");
+}
+
+TEST(EvalTest, TestLargeArrays)
+{
+	// Linear only if push appends in place and rest does not copy
+	std::string input = R"(
+let build = fn(n, arr) { if (n == 0) { arr } else { build(n - 1, push(arr, n)) } };
+let sum = fn(arr, acc) { if (len(arr) == 0) { acc } else { sum(rest(arr), acc + first(arr)) } };
+let arr = build(100000, []);
+sum(arr, 0) + arr[99999] + len(arr)
+)";
+
+	test_int_obj(test_eval(input), 5000050000 + 1 + 100000, input);
+}
+
+TEST(EvalTest, TestHashLiterals)
+{
+	std::pair<std::string, std::string> expected[] = {
+		std::pair("{:}", "{}"),
+		std::pair(R"({"one": 10 - 9})", "{one: 1}"),
+		std::pair("{true: [1, 2]}", "{true: [1, 2]}"),
+		// The last value given for a key wins
+		std::pair(R"(let two = "two"; {"two": 1, two: 2})", "{two: 2}"),
+	};
+
+	for (auto& tt : expected)
+	{
+		auto evaluated = test_eval(tt.first);
+		ASSERT_EQ(interp::object::ObjectType::HashObject, evaluated.type()) << "object is not HashObject for: " << tt.first;
+		EXPECT_EQ(tt.second, evaluated.inspect());
+	}
+
+	test_int_obj(test_eval(R"(len({"one": 1, "two": 2, 3: 3, 4: 4, true: 5, false: 6}))"), 6, "len");
+	test_error(test_eval("{[1]: 2}"), "unusable as hash key: ARRAY", "{[1]: 2}");
+}
+
+TEST(EvalTest, TestHashIndexExpressions)
+{
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair(R"({"foo": 5}["foo"])", 5),
+		std::pair(R"(let key = "foo"; {"foo": 5}[key])", 5),
+		std::pair(R"({"f" + "oo": 5}["fo" + "o"])", 5),
+		std::pair("{5: 5}[5]", 5),
+		std::pair("{-5: 5}[0 - 5]", 5),
+		std::pair("{true: 5}[true]", 5),
+		std::pair("{false: 5}[false]", 5),
+		std::pair("{1: 1, true: 2}[true]", 2),
+	};
+
+	for (auto& tt : expected)
+	{
+		test_int_obj(test_eval(tt.first), tt.second, tt.first);
+	}
+
+	test_null_obj(test_eval(R"({"foo": 5}["bar"])"), "missing key");
+	test_null_obj(test_eval(R"({:}["foo"])"), "empty hash");
+	test_null_obj(test_eval("{1: 1}[true]"), "key of another type");
+	test_error(test_eval(R"({"name": "Monkey"}[fn(x) { x }])"), "unusable as hash key: FunctionObject", "function key");
+}
+
+TEST(EvalTest, TestLargeHashes)
+{
+	// 2000 string and 2000 integer keys, each looked up
+	std::string literal = "{";
+	for (int i = 0; i < 2000; i++)
+	{
+		literal += (i ? ", " : "") + std::string("\"k") + std::to_string(i) + "\": " + std::to_string(i) + ", " + std::to_string(i) + ": " + std::to_string(i * 2);
+	}
+	literal += "}";
+	test_int_obj(test_eval("len(" + literal + ")"), 4000, "len of large hash");
+
+	auto hash = test_eval(literal);
+	ASSERT_EQ(interp::object::ObjectType::HashObject, hash.type());
+
+	for (int i = 0; i < 2000; i++)
+	{
+		auto found = hash.as<interp::object::HashObject>()->get(interp::object::Value::integer(i));
+		ASSERT_TRUE(found) << "missing key " << i;
+		EXPECT_EQ(i * 2, found->as_integer());
+
+		auto key = interp::object::make_ref<interp::object::StringObject>("k" + std::to_string(i));
+		found = hash.as<interp::object::HashObject>()->get(key);
+		ASSERT_TRUE(found) << "missing key k" << i;
+		EXPECT_EQ(i, found->as_integer());
+	}
+	EXPECT_FALSE(hash.as<interp::object::HashObject>()->get(interp::object::Value::integer(2000)));
+}
+
+TEST(EvalTest, TestFunctionOutlivesProgram)
+{
+	auto env = interp::object::Environment::new_env(nullptr);
+
+	{
+		interp::lexer::Lexer lex("let addOne = fn(x) { x + 1 };");
+		interp::parser::Parser parse(lex);
+		auto prog = parse.parse_program();
+		interp::eval::eval(prog.get(), env);
+	}
+
+	interp::lexer::Lexer lex("addOne(41)");
+	interp::parser::Parser parse(lex);
+	auto prog = parse.parse_program();
+	auto obj = interp::eval::eval(prog.get(), env);
+	test_int_obj(obj, 42, "addOne(41)");
+}
+
+TEST(EvalTest, TestLexicalScoping)
+{
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair("let newAdder = fn(x) { fn(y) { x + y } }; let addTwo = newAdder(2); addTwo(3);", 5),
+		std::pair("let f = fn() { g() }; let g = fn() { 7 }; f();", 7),
+		std::pair("let x = 1; let f = fn(x) { let x = x * 10; x }; f(2) + x;", 21),
+		std::pair("let x = 1; if (true) { let x = 2; x }; x;", 1),
+		std::pair("let x = 1; let f = fn() { if (true) { x + 1 } }; f();", 2),
+		std::pair("let f = fn(n) { let go = fn(i) { if (i == 0) { 0 } else { 1 + go(i - 1) } }; go(n) }; f(5);", 5),
+		// A use before a later let in its own scope still names the outer variable
+		std::pair("let f = fn() { let y = x; let x = 5; y }; let x = 1; f();", 1),
+		std::pair("let f = fn() { if (true) { let y = x; let x = 5; y } }; let x = 1; f();", 1),
+		std::pair("let f = fn() { let g = fn() { x }; let x = 5; g() }; let x = 1; f();", 5),
+		std::pair("let x = 1; let f = fn() { let g = fn() { x }; let x = 2; g() }; f();", 2),
+		std::pair("let x = 1; let f = fn() { let x = 3; if (true) { let g = fn() { x }; let x = 4; g() } }; f();", 4),
+		std::pair("let x = 1; let f = fn() { let x = 3; let g = fn() { let h = fn() { x }; h() }; g() }; f();", 3),
+		// Variables of blocks in a function share the call's environment
+		std::pair("let f = fn(x) { let a = if (x > 0) { let y = x * 2; y } else { let y = 1; y }; let b = { let y = a + 1; y }; a + b }; f(3) + f(0);", 16),
+		std::pair("let f = fn(x) { if (true) { let x = x + 1; let g = fn() { x }; g } }; f(1)() + f(10)();", 13),
+		std::pair("let f = fn(x) { let y = { let x = x + 1; { let x = x * 10; x } }; x + y }; f(1);", 21),
+	};
+
+	for (auto& tt : expected)
+	{
+		auto obj = test_eval(tt.first);
+		test_int_obj(obj, tt.second, tt.first);
+	}
+
+	auto obj = test_eval("if (true) { y; let y = 1; }");
+	test_error(obj, "identifier not found: y", "if (true) { y; let y = 1; }");
+}
+
+TEST(EvalTest, TestLoops)
+{
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair("let i = 0; let sum = 0; while (i < 10) { sum = sum + i; i = i + 1 }; sum;", 45),
+		std::pair("let i = 0; while (i < 100000) { i = i + 1 }; i;", 100000),
+		std::pair("let x = 1; let y = x = 5; x + y;", 10),
+		std::pair("let i = 0; while (i < 3) { let j = i * 2; i = i + 1 }; i;", 3),
+		std::pair("let sum = 0; for (x in [1, 2, 3]) { sum = sum + x }; sum;", 6),
+		std::pair("let n = 0; for (x in [1, 2]) { for (y in [10, 20]) { n = n + x * y } }; n;", 90),
+		// The loop keeps iterating the array it started with
+		std::pair("let a = [1, 2]; let n = 0; for (x in a) { a = push(a, x); n = n + 1 }; n + len(a);", 6),
+		std::pair("let f = fn() { let i = 0; while (true) { if (i == 5) { return i; } i = i + 1 } }; f();", 5),
+		std::pair("for (x in [1, 2, 3]) { if (x == 2) { return x * 10; } }", 20),
+		// Closures made in a loop keep the iteration they were made in
+		std::pair("let fs = []; for (x in [1, 2, 3]) { fs = push(fs, fn() { x }) }; fs[0]() + fs[2]();", 4),
+		std::pair("let fs = []; let i = 0; while (i < 3) { let j = i; fs = push(fs, fn() { j }); i = i + 1 }; fs[1]();", 1),
 	};
 
 	for (auto& tt : expected)
 	{
 		auto obj = test_eval(tt.first);
-		test_error(obj.get(), tt.second, tt.first);
+		test_int_obj(obj, tt.second, tt.first);
 	}
+
+	for (auto input : { "while (false) { 1 }", "for (x in []) { x }" })
+	{
+		auto obj = test_eval(input);
+		test_null_obj(obj, input);
+	}
+
+	std::pair<std::string, std::string> errors[] = {
+		std::pair("x = 1", "identifier not found: x"),
+		std::pair("for (x in 5) { x }", "cannot iterate over INTEGER"),
+		std::pair("let i = 0; while (i < 3) { i = i + y }", "identifier not found: y"),
+	};
+
+	for (auto& tt : errors)
+	{
+		auto obj = test_eval(tt.first);
+		test_error(obj, tt.second, tt.first);
+	}
+}
+
+TEST(EvalTest, TestReturnStatements)
+{
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair("return 10;", 10),
+		std::pair("return 10; 9;", 10),
+		std::pair("9; return 2 * 5; 9;", 10),
+		std::pair("if (10 > 1) { if (10 > 1) { return 10; } return 1; }", 10),
+		std::pair("let f = fn() { return 5; }; f() + 1;", 6),
+		std::pair("let f = fn() { return 1; 2 }; f(); 10;", 10),
+		std::pair("let f = fn(x) { if (x > 1) { return x; } 0 }; f(3) + f(1);", 3),
+	};
+
+	for (auto& tt : expected)
+	{
+		auto obj = test_eval(tt.first);
+		test_int_obj(obj, tt.second, tt.first);
+	}
+
+	auto obj = test_eval("if (true) {}");
+	test_null_obj(obj, "if (true) {}");
 }
 
-std::shared_ptr<interp::object::Object> test_eval(std::string input)
+TEST(EvalTest, TestTailCalls)
+{
+	// Deep enough to overflow the native stack if tail calls recursed
+	std::pair<std::string, int64_t> expected[] = {
+		std::pair("let count = fn(n) { if (n == 0) { 0 } else { count(n - 1) } }; count(1000000);", 0),
+		std::pair("let sum = fn(n, acc) { if (n == 0) { return acc; } sum(n - 1, acc + n) }; sum(1000000, 0);", 500000500000),
+		std::pair("let even = fn(n) { if (n == 0) { true } else { odd(n - 1) } }; let odd = fn(n) { if (n == 0) { false } else { even(n - 1) } }; if (even(1000001)) { 1 } else { 2 };", 2),
+		std::pair("let f = fn(n) { return g(n); }; let g = fn(n) { if (n > 0) { return f(n - 1); } 7 }; f(1000000);", 7),
+	};
+
+	for (auto& tt : expected)
+	{
+		auto obj = test_eval(tt.first);
+		test_int_obj(obj, tt.second, tt.first);
+	}
+}
+
+TEST(EvalTest, TestHeapStackDepth)
+{
+	interp::lexer::Lexer lex("let sum = fn(n) { if (n == 0) { 0 } else { n + sum(n - 1) } }; sum(50000);");
+	interp::parser::Parser parse(lex);
+	auto prog = parse.parse_program();
+
+	// Far deeper than the tree walker can recurse natively
+	auto env = interp::object::Environment::new_env(nullptr);
+	test_int_obj(interp::eval::StackEvaluator().run(prog.get(), env), 1250025000, "sum(50000)");
+
+	env = interp::object::Environment::new_env(nullptr);
+	test_error(interp::eval::StackEvaluator(1000).run(prog.get(), env), "maximum call depth exceeded: 1000", "sum(50000)");
+
+	// Tail calls do not count towards the depth
+	interp::lexer::Lexer tail_lex("let count = fn(n) { if (n == 0) { 0 } else { count(n - 1) } }; count(5000);");
+	interp::parser::Parser tail_parse(tail_lex);
+	auto tail_prog = tail_parse.parse_program();
+
+	env = interp::object::Environment::new_env(nullptr);
+	test_int_obj(interp::eval::StackEvaluator(1000).run(tail_prog.get(), env), 0, "count(5000)");
+}
+
+TEST(EvalTest, TestClosureCyclesAreCollected)
+{
+	// Each call to make leaves behind a block environment and a closure that
+	// refer to each other, which reference counting alone never frees
+	auto input = "let make = fn() { let g = fn() { g }; g }; "
+		"let loop = fn(i) { if (i == 0) { 0 } else { make(); loop(i - 1) } }; "
+		"loop(200000);";
+
+	test_int_obj(test_eval(input), 0, input);
+
+	// Three engines leaving three objects per iteration would be 1.8 million
+	auto stats = interp::object::gc::stats();
+	EXPECT_LT(stats.tracked, 5 * interp::object::gc::MIN_THRESHOLD) << "tracked objects";
+	EXPECT_GT(stats.collections, 0) << "collections";
+
+	// With the program gone the globals are a cycle too
+	interp::object::gc::collect();
+	EXPECT_EQ(interp::object::gc::stats().tracked, 0) << "tracked objects after collect";
+}
+
+TEST(EvalTest, TestArrayCyclesAreCollected)
+{
+	// The array holds a closure over the environment holding the array
+	auto input = "let make = fn() { let a = [fn() { a }]; a }; "
+		"let loop = fn(i) { if (i == 0) { 0 } else { make(); loop(i - 1) } }; "
+		"loop(200000);";
+
+	test_int_obj(test_eval(input), 0, input);
+	EXPECT_LT(interp::object::gc::stats().tracked, 5 * interp::object::gc::MIN_THRESHOLD) << "tracked objects";
+
+	interp::object::gc::collect();
+	EXPECT_EQ(interp::object::gc::stats().tracked, 0) << "tracked objects after collect";
+}
+
+TEST(EvalTest, TestNurseryPromotion)
+{
+	auto size = interp::object::nursery::size();
+	interp::object::nursery::set_size(1024);
+	interp::object::nursery::reset_stats();
+
+	// Dead objects are reclaimed in place, kept ones get their chunk promoted
+	std::vector<interp::object::Ref<interp::object::StringObject>> kept;
+	for (int i = 0; i < 5000; i++)
+	{
+		auto str = interp::object::nursery::make<interp::object::StringObject>(std::to_string(i));
+		if (i % 100 == 0)
+		{
+			kept.push_back(str);
+		}
+	}
+
+	auto stats = interp::object::nursery::stats();
+	EXPECT_EQ(stats.hits, 5000) << "nursery hits";
+	EXPECT_EQ(stats.misses, 0) << "nursery misses";
+	EXPECT_GT(stats.promotions, 0) << "promotions";
+	EXPECT_LE(stats.promotions, kept.size()) << "promotions";
+	EXPECT_EQ(kept[3]->value(), "300");
+
+	interp::object::nursery::set_size(size);
+}
+
+TEST(EvalTest, TestPoolReuse)
+{
+	// A released block is the next one handed out for its size class
+	auto first = interp::object::pool::allocate(40);
+	interp::object::pool::release(first, 40);
+	auto second = interp::object::pool::allocate(48);
+	EXPECT_EQ(first, second);
+	interp::object::pool::release(second, 48);
+
+	auto env = interp::object::pool::make<interp::object::Environment>(nullptr, 2);
+	env->set(1, interp::object::Value::integer(5));
+	EXPECT_EQ(env->get(0, 1).as_integer(), 5);
+}
+
+interp::object::Value test_eval(std::string input)
 {
 	interp::lexer::Lexer lex(input);
 	interp::parser::Parser parse(lex);
@@ -198,16 +664,35 @@ std::shared_ptr<interp::object::Object> test_eval(std::string input)
 	auto prog = parse.parse_program();
 
 	auto env = interp::object::Environment::new_env(nullptr);
-	return interp::eval::eval(prog, env);
+	auto result = interp::eval::eval(prog.get(), env);
+
+	// Every case also runs on the other engines, which have to agree
+	interp::object::Value (*engines[])(interp::ast::Program*, interp::object::Ref<interp::object::Environment>&) = {
+		interp::vm::run,
+		interp::eval::eval_on_heap,
+	};
+	for (auto engine : engines)
+	{
+		auto engine_env = interp::object::Environment::new_env(nullptr);
+		auto engine_result = engine(prog.get(), engine_env);
+		EXPECT_EQ(static_cast<bool>(result), static_cast<bool>(engine_result)) << "Engines disagree on: " << input;
+		if (result && engine_result)
+		{
+			EXPECT_EQ(result.type(), engine_result.type()) << "Engines disagree on: " << input;
+			EXPECT_EQ(result.inspect(), engine_result.inspect()) << "Engines disagree on: " << input;
+		}
+	}
+
+	return result;
 }
 
-bool test_int_obj(const interp::object::Object* in_object, int64_t expected, std::string input)
+bool test_int_obj(const interp::object::Value& in_object, int64_t expected, std::string input)
 {
-	if (auto obj = dynamic_cast<const interp::object::Integer*>(in_object))
+	if (in_object.type() == interp::object::ObjectType::IntegerObject)
 	{
-		if (obj->value != expected)
+		if (in_object.as_integer() != expected)
 		{
-			EXPECT_TRUE(false) << "Integer has wrong value. Expected " << expected << " got " << obj->value << "\nFailed for: " << input;
+			EXPECT_TRUE(false) << "Integer has wrong value. Expected " << expected << " got " << in_object.as_integer() << "\nFailed for: " << input;
 			return false;
 		}
 		else
@@ -217,19 +702,19 @@ bool test_int_obj(const interp::object::Object* in_object, int64_t expected, std
 	{
 		EXPECT_TRUE(false) 
 			<< "Object is not an Interger, type is " 
-			<< interp::object::object_type_to_string(in_object->type())
+			<< interp::object::object_type_to_string(in_object.type())
 			<< "\nFailed for " << input;
 		return false;
 	}
 }
 
-bool test_bool_obj(const interp::object::Object* in_object, bool expected, std::string input)
+bool test_bool_obj(const interp::object::Value& in_object, bool expected, std::string input)
 {
-	if (auto obj = dynamic_cast<const interp::object::BooleanObject*>(in_object))
+	if (in_object.type() == interp::object::ObjectType::BooleanObject)
 	{
-		if (obj->value != expected)
+		if (in_object.as_boolean() != expected)
 		{
-			EXPECT_TRUE(false) << "Integer has wrong value. Expected " << expected << " got " << obj->value << "\nFailed for: " << input;
+			EXPECT_TRUE(false) << "Integer has wrong value. Expected " << expected << " got " << in_object.as_boolean() << "\nFailed for: " << input;
 			return false;
 		}
 		else
@@ -237,18 +722,18 @@ bool test_bool_obj(const interp::object::Object* in_object, bool expected, std::
 	}
 	else
 	{
-		EXPECT_TRUE(false) << "Object is not an Boolean, type is " << interp::object::object_type_to_string(in_object->type()) << "\nFailed for: " << input;
+		EXPECT_TRUE(false) << "Object is not an Boolean, type is " << interp::object::object_type_to_string(in_object.type()) << "\nFailed for: " << input;
 		return false;
 	}
 }
 
-bool test_string_obj(const interp::object::Object* in_object, std::string expected, std::string input)
+bool test_string_obj(const interp::object::Value& in_object, std::string expected, std::string input)
 {
-	if (auto obj = dynamic_cast<const interp::object::StringObject*>(in_object))
+	if (auto obj = dynamic_cast<const interp::object::StringObject*>(in_object.object()))
 	{
-		if (obj->value != expected)
+		if (obj->value() != expected)
 		{
-			EXPECT_TRUE(false) << "String has wrong value. Expected " << expected << " got " << obj->value << "\nFailed for: " << input;
+			EXPECT_TRUE(false) << "String has wrong value. Expected " << expected << " got " << obj->value() << "\nFailed for: " << input;
 			return false;
 		}
 		else
@@ -256,27 +741,27 @@ bool test_string_obj(const interp::object::Object* in_object, std::string expect
 	}
 	else
 	{
-		EXPECT_TRUE(false) << "Object is not an String, type is " << interp::object::object_type_to_string(in_object->type()) << "\nFailed for: " << input;
+		EXPECT_TRUE(false) << "Object is not an String, type is " << interp::object::object_type_to_string(in_object.type()) << "\nFailed for: " << input;
 		return false;
 	}
 }
 
-bool test_null_obj(const interp::object::Object* in_object, std::string input)
+bool test_null_obj(const interp::object::Value& in_object, std::string input)
 {
-	if (auto obj = dynamic_cast<const interp::object::Null*>(in_object))
+	if (in_object.type() == interp::object::ObjectType::NullObject)
 	{
 		return true;
 	}
 	else
 	{
-		EXPECT_TRUE(false) << "Object is not an Null, type is " << interp::object::object_type_to_string(in_object->type()) << "\nFailed for: " << input;
+		EXPECT_TRUE(false) << "Object is not an Null, type is " << interp::object::object_type_to_string(in_object.type()) << "\nFailed for: " << input;
 		return false;
 	}
 }
 
-bool test_error(const interp::object::Object* in_object, std::string expected, std::string input)
+bool test_error(const interp::object::Value& in_object, std::string expected, std::string input)
 {
-	if (auto obj = dynamic_cast<const interp::object::ErrorObject*>(in_object))
+	if (auto obj = dynamic_cast<const interp::object::ErrorObject*>(in_object.object()))
 	{
 		if (obj->message != expected)
 		{
@@ -294,9 +779,9 @@ bool test_error(const interp::object::Object* in_object, std::string expected, s
 	{
 		EXPECT_TRUE(false)
 			<< "Object is not an Error, got "
-			<< interp::object::object_type_to_string(in_object->type())
+			<< interp::object::object_type_to_string(in_object.type())
 			<< ": "
-			<< in_object->inspect() << "\nFailed for: " << input;
+			<< in_object.inspect() << "\nFailed for: " << input;
 
 		return false;
 	}
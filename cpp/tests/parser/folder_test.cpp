@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "parser.h"
+#include "eval.h"
+#include "folder.h"
+
+std::shared_ptr<interp::ast::Program> test_fold(std::string input);
+
+TEST(FolderTest, TestFoldConstants)
+{
+	std::pair<std::string, std::string> expected[] = {
+		std::pair("let day = 60 * 60 * 24;", "let day = 86400;"),
+		std::pair("-(2 + 3)", "-5"),
+		std::pair("!true == false", "true"),
+		std::pair("\"foo\" + \"bar\"", "foobar"),
+		std::pair("fn(x) { x * (2 + 3) }", "fn(x) { (x * 5) }"),
+		std::pair("if (1 < 2) { 10 } else { 20 }", "{ 10 }"),
+		std::pair("(if (false) { 1 } else { 2 }) * x", "({ 2 } * x)"),
+		std::pair("(if (false) { 1 } else { 2 }) * 3", "6"),
+		// Errors and values without a literal are left for run time
+		std::pair("5 / 0", "(5 / 0)"),
+		std::pair("1 + true", "(1 + true)"),
+		std::pair("if (false) { 1 }", "if false { 1 }"),
+	};
+
+	for (auto& tt : expected)
+	{
+		auto prog = test_fold(tt.first);
+		EXPECT_EQ(tt.second, prog->string()) << "Failed for: " << tt.first;
+	}
+}
+
+TEST(FolderTest, TestLiteralsAreShared)
+{
+	auto prog = test_fold("\"hello\"");
+
+	auto env = interp::object::Environment::new_env(nullptr);
+	auto first = interp::eval::eval(prog.get(), env);
+	auto second = interp::eval::eval(prog.get(), env);
+
+	ASSERT_EQ(first.type(), interp::object::ObjectType::StringObject);
+	EXPECT_EQ(first.inspect(), "hello");
+	EXPECT_TRUE(first.identical(second)) << "every evaluation should produce the same object";
+}
+
+std::shared_ptr<interp::ast::Program> test_fold(std::string input)
+{
+	interp::lexer::Lexer lex(input);
+	interp::parser::Parser parse(lex);
+	auto prog = parse.parse_program();
+
+	EXPECT_EQ(0, parse.get_errors().size()) << "Parser errors for: " << input;
+
+	interp::parser::Folder(*prog->arena).fold(prog.get());
+	return prog;
+}
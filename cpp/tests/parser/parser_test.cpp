@@ -4,10 +4,10 @@
 #include "parser.h"
 
 void check_parser_errors(interp::parser::Parser p);
-void test_let_statment(std::shared_ptr<interp::ast::Statement> stmnt, std::string name);
-void test_integer_literal(std::shared_ptr<interp::ast::Expression> expr, int64_t value);
-void test_identifier(std::shared_ptr<interp::ast::Expression> expr, std::string value);
-void test_boolean(std::shared_ptr<interp::ast::Expression> expr, bool value);
+void test_let_statment(interp::ast::Statement* stmnt, std::string name);
+void test_integer_literal(interp::ast::Expression* expr, int64_t value);
+void test_identifier(interp::ast::Expression* expr, std::string value);
+void test_boolean(interp::ast::Expression* expr, bool value);
 
 TEST(ParserTest, TestLetStatment)
 {
@@ -54,7 +54,7 @@ return 838383;
 
 	for (auto stmnt : prog->statements)
 	{
-		if (interp::ast::ReturnStatement *retstmnt = dynamic_cast<interp::ast::ReturnStatement *>(stmnt.get()))
+		if (interp::ast::ReturnStatement *retstmnt = dynamic_cast<interp::ast::ReturnStatement *>(stmnt))
 		{
 			EXPECT_EQ("return", retstmnt->token_literal()) << "token literal not return got " << retstmnt->token_literal();
 		}
@@ -78,9 +78,9 @@ TEST(ParserTest, TestIdentifierExpression)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement *expstmnt = dynamic_cast<interp::ast::ExpressionStatement *>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement *expstmnt = dynamic_cast<interp::ast::ExpressionStatement *>(prog->statements[0]))
 	{
-		if (interp::ast::Identifier *ident = dynamic_cast<interp::ast::Identifier *>(expstmnt->expression.get()))
+		if (interp::ast::Identifier *ident = dynamic_cast<interp::ast::Identifier *>(expstmnt->expression))
 		{
 			EXPECT_EQ("foobar", ident->value) << "value not foobar got " << ident->value;
 			EXPECT_EQ("foobar", ident->token_literal()) << "token literal not foobar got " << ident->token_literal();
@@ -109,9 +109,9 @@ TEST(ParserTest, TestIntegerLiteral)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement *expstmnt = dynamic_cast<interp::ast::ExpressionStatement *>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement *expstmnt = dynamic_cast<interp::ast::ExpressionStatement *>(prog->statements[0]))
 	{
-		if (interp::ast::IntegerLiteral *intlit = dynamic_cast<interp::ast::IntegerLiteral *>(expstmnt->expression.get()))
+		if (interp::ast::IntegerLiteral *intlit = dynamic_cast<interp::ast::IntegerLiteral *>(expstmnt->expression))
 		{
 			EXPECT_EQ(5LL, intlit->value) << "value not 5 got " << intlit->value;
 			EXPECT_EQ("5", intlit->token_literal()) << "token literal not 5 got " << intlit->token_literal();
@@ -140,9 +140,9 @@ TEST(ParserTest, TestStringLiteral)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (auto strLit = dynamic_cast<interp::ast::StringLiteral*>(expstmnt->expression.get()))
+		if (auto strLit = dynamic_cast<interp::ast::StringLiteral*>(expstmnt->expression))
 		{
 			EXPECT_EQ("hello world", strLit->value) << "value not \"hello world\" got \"" << strLit->value << "\"";
 		}
@@ -170,9 +170,9 @@ TEST(ParserTest, TestBooleanExpression)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::BooleanLiteral* ident = dynamic_cast<interp::ast::BooleanLiteral*>(expstmnt->expression.get()))
+		if (interp::ast::BooleanLiteral* ident = dynamic_cast<interp::ast::BooleanLiteral*>(expstmnt->expression))
 		{
 			EXPECT_EQ(true, ident->value) << "value not true got " << ident->value;
 			EXPECT_EQ("true", ident->token_literal()) << "token literal not true got " << ident->token_literal();
@@ -207,12 +207,13 @@ TEST(ParserTest, TestPrefixExpression)
 		ASSERT_EQ(1, prog->statements.size())
 			<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-		if (interp::ast::ExpressionStatement *expstmnt = dynamic_cast<interp::ast::ExpressionStatement *>(prog->statements[0].get()))
+		if (interp::ast::ExpressionStatement *expstmnt = dynamic_cast<interp::ast::ExpressionStatement *>(prog->statements[0]))
 		{
-			if (interp::ast::PrefixExpression *pref = dynamic_cast<interp::ast::PrefixExpression *>(expstmnt->expression.get()))
+			if (interp::ast::PrefixExpression *pref = dynamic_cast<interp::ast::PrefixExpression *>(expstmnt->expression))
 			{
 
 				EXPECT_EQ(std::get<1>(tt), pref->p_operator) << "operatior not " << std::get<1>(tt) << " got " << pref->p_operator;
+				EXPECT_EQ(std::get<1>(tt), interp::ast::operator_to_string(pref->op)) << "resolved operator does not match " << std::get<1>(tt);
 
 				test_integer_literal(pref->right, std::get<2>(tt));
 			}
@@ -255,13 +256,14 @@ TEST(ParserTest, TestInfixExpression)
 		ASSERT_EQ(1, prog->statements.size())
 			<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-		if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+		if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 		{
-			if (interp::ast::InfixExpression* pref = dynamic_cast<interp::ast::InfixExpression*>(expstmnt->expression.get()))
+			if (interp::ast::InfixExpression* pref = dynamic_cast<interp::ast::InfixExpression*>(expstmnt->expression))
 			{
 				test_integer_literal(pref->left, std::get<1>(tt));
 
 				EXPECT_EQ(std::get<2>(tt), pref->p_operator) << "operatior not " << std::get<2>(tt) << " got " << pref->p_operator;
+				EXPECT_EQ(std::get<2>(tt), interp::ast::operator_to_string(pref->op)) << "resolved operator does not match " << std::get<2>(tt);
 
 				test_integer_literal(pref->right, std::get<3>(tt));
 			}
@@ -290,6 +292,12 @@ TEST(ParserTest, TestOperatorPrecedence)
 		std::tuple("2 / (5 + 5)", "(2 / (5 + 5))"),
 		std::tuple("-(5 + 5)", "(-(5 + 5))"),
 		std::tuple("!(true == true)", "(!(true == true))"),
+
+		std::tuple("a * [1, 2, 3, 4][b * c] * d", "((a * ([1, 2, 3, 4][(b * c)])) * d)"),
+		std::tuple("add(a * b[2], b[1], 2 * [1, 2][1])", "add((a * (b[2])), (b[1]), (2 * ([1, 2][1])))"),
+
+		std::tuple("x = y = 1 + 2", "(x = (y = (1 + 2)))"),
+		std::tuple("a = b == c", "(a = (b == c))"),
 	};
 
 	for (auto tt : expected)
@@ -321,11 +329,11 @@ TEST(ParserTest, TestIfExpressionWithBlock)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression.get()))
+		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression))
 		{
-			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition.get()))
+			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition))
 			{
 				test_integer_literal(condition->left, 7);
 
@@ -338,12 +346,12 @@ TEST(ParserTest, TestIfExpressionWithBlock)
 				EXPECT_TRUE(false) << "expression not InfixExpression";
 			}
 
-			if (interp::ast::BlockExpression* consequence = dynamic_cast<interp::ast::BlockExpression*>(ifExpr->consequence.get()))
+			if (interp::ast::BlockExpression* consequence = dynamic_cast<interp::ast::BlockExpression*>(ifExpr->consequence))
 			{
 				ASSERT_EQ(1, consequence->statements.size())
 					<< "consequence.statements does not contain 1 statement. got=" << std::to_string(consequence->statements.size());
 
-				if (interp::ast::ExpressionStatement* stmnt = dynamic_cast<interp::ast::ExpressionStatement*>(consequence->statements[0].get()))
+				if (interp::ast::ExpressionStatement* stmnt = dynamic_cast<interp::ast::ExpressionStatement*>(consequence->statements[0]))
 				{
 					test_identifier(stmnt->expression, "x");
 				}
@@ -381,11 +389,11 @@ TEST(ParserTest, TestIfExpression)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression.get()))
+		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression))
 		{
-			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition.get()))
+			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition))
 			{
 				test_integer_literal(condition->left, 7);
 
@@ -425,11 +433,11 @@ TEST(ParserTest, TestIfElseExpressionWithBlock)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression.get()))
+		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression))
 		{
-			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition.get()))
+			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition))
 			{
 				test_integer_literal(condition->left, 7);
 
@@ -442,12 +450,12 @@ TEST(ParserTest, TestIfElseExpressionWithBlock)
 				EXPECT_TRUE(false) << "expression not InfixExpression";
 			}
 
-			if (interp::ast::BlockExpression* consequence = dynamic_cast<interp::ast::BlockExpression*>(ifExpr->consequence.get()))
+			if (interp::ast::BlockExpression* consequence = dynamic_cast<interp::ast::BlockExpression*>(ifExpr->consequence))
 			{
 				ASSERT_EQ(1, consequence->statements.size())
 					<< "consequence.statements does not contain 1 statement. got=" << std::to_string(consequence->statements.size());
 
-				if (interp::ast::ExpressionStatement* stmnt = dynamic_cast<interp::ast::ExpressionStatement*>(consequence->statements[0].get()))
+				if (interp::ast::ExpressionStatement* stmnt = dynamic_cast<interp::ast::ExpressionStatement*>(consequence->statements[0]))
 				{
 					test_identifier(stmnt->expression, "x");
 				}
@@ -462,12 +470,12 @@ TEST(ParserTest, TestIfElseExpressionWithBlock)
 			}
 
 
-			if (interp::ast::BlockExpression* alternative = dynamic_cast<interp::ast::BlockExpression*>(ifExpr->alternative.get()))
+			if (interp::ast::BlockExpression* alternative = dynamic_cast<interp::ast::BlockExpression*>(ifExpr->alternative))
 			{
 				ASSERT_EQ(1, alternative->statements.size())
 					<< "consequence.statements does not contain 1 statement. got=" << std::to_string(alternative->statements.size());
 
-				if (interp::ast::ExpressionStatement* stmnt = dynamic_cast<interp::ast::ExpressionStatement*>(alternative->statements[0].get()))
+				if (interp::ast::ExpressionStatement* stmnt = dynamic_cast<interp::ast::ExpressionStatement*>(alternative->statements[0]))
 				{
 					test_identifier(stmnt->expression, "x");
 				}
@@ -505,11 +513,11 @@ TEST(ParserTest, TestIfElseExpression)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression.get()))
+		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression))
 		{
-			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition.get()))
+			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition))
 			{
 				test_integer_literal(condition->left, 7);
 
@@ -550,11 +558,11 @@ TEST(ParserTest, TestIfElseIfExpression)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression.get()))
+		if (interp::ast::IfExpression* ifExpr = dynamic_cast<interp::ast::IfExpression*>(expstmnt->expression))
 		{
-			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition.get()))
+			if (interp::ast::InfixExpression* condition = dynamic_cast<interp::ast::InfixExpression*>(ifExpr->condition))
 			{
 				test_integer_literal(condition->left, 7);
 
@@ -569,7 +577,7 @@ TEST(ParserTest, TestIfElseIfExpression)
 
 
 			test_identifier(ifExpr->consequence, "x");
-			if (interp::ast::IfExpression* ElseifExpr = dynamic_cast<interp::ast::IfExpression*>(ifExpr->alternative.get()))
+			if (interp::ast::IfExpression* ElseifExpr = dynamic_cast<interp::ast::IfExpression*>(ifExpr->alternative))
 			{
 				test_boolean(ElseifExpr->condition, true);
 				test_identifier(ElseifExpr->consequence, "y");
@@ -599,9 +607,9 @@ TEST(ParserTest, TestFunctionLiteralWithBlock)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression.get()))
+		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression))
 		{
 			ASSERT_EQ(2, fnLit->params.size())
 				<< "fn params does not contain 2 identifiers, got=" << std::to_string(fnLit->params.size());
@@ -610,14 +618,14 @@ TEST(ParserTest, TestFunctionLiteralWithBlock)
 			test_identifier(fnLit->params[1], "y");
 
 
-			if (interp::ast::BlockExpression* fnBody = dynamic_cast<interp::ast::BlockExpression*>(fnLit->body.get()))
+			if (interp::ast::BlockExpression* fnBody = dynamic_cast<interp::ast::BlockExpression*>(fnLit->body))
 			{
 				ASSERT_EQ(1, fnBody->statements.size())
 					<< "consequence.statements does not contain 1 statement. got=" << std::to_string(fnBody->statements.size());
 
-				if (interp::ast::ExpressionStatement* fnExpr = dynamic_cast<interp::ast::ExpressionStatement*>(fnBody->statements[0].get()))
+				if (interp::ast::ExpressionStatement* fnExpr = dynamic_cast<interp::ast::ExpressionStatement*>(fnBody->statements[0]))
 				{
-					if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnExpr->expression.get()))
+					if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnExpr->expression))
 					{
 						test_identifier(fnStmnt->left, "x");
 
@@ -664,9 +672,9 @@ TEST(ParserTest, TestFunctionLiteralTwoParams)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression.get()))
+		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression))
 		{
 			ASSERT_EQ(2, fnLit->params.size())
 				<< "fn params does not contain 2 identifiers, got=" << std::to_string(fnLit->params.size());
@@ -675,7 +683,7 @@ TEST(ParserTest, TestFunctionLiteralTwoParams)
 			test_identifier(fnLit->params[1], "y");
 
 
-			if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body.get()))
+			if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body))
 			{
 				test_identifier(fnStmnt->left, "x");
 
@@ -712,15 +720,15 @@ TEST(ParserTest, TestFunctionLiteralNoParams)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression.get()))
+		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression))
 		{
 			ASSERT_EQ(0, fnLit->params.size())
 				<< "fn params does not contain 2 identifiers, got=" << std::to_string(fnLit->params.size());
 
 
-			if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body.get()))
+			if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body))
 			{
 				test_identifier(fnStmnt->left, "x");
 
@@ -757,9 +765,9 @@ TEST(ParserTest, TestFunctionLiteralOneParam)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression.get()))
+		if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(expstmnt->expression))
 		{
 			ASSERT_EQ(1, fnLit->params.size())
 				<< "fn params does not contain 1 identifiers, got=" << std::to_string(fnLit->params.size());
@@ -767,7 +775,7 @@ TEST(ParserTest, TestFunctionLiteralOneParam)
 			test_identifier(fnLit->params[0], "x");
 
 
-			if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body.get()))
+			if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body))
 			{
 				test_identifier(fnStmnt->left, "x");
 
@@ -791,6 +799,208 @@ TEST(ParserTest, TestFunctionLiteralOneParam)
 	}
 }
 
+TEST(ParserTest, TestArrayLiteral)
+{
+	std::string input = "[1, 2 * 2, 3 + 3]";
+
+	interp::lexer::Lexer lex(input);
+	interp::parser::Parser parse(lex);
+
+	auto prog = parse.parse_program();
+	check_parser_errors(parse);
+
+	ASSERT_EQ(1, prog->statements.size())
+		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
+
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
+	{
+		if (interp::ast::ArrayLiteral* array = dynamic_cast<interp::ast::ArrayLiteral*>(expstmnt->expression))
+		{
+			ASSERT_EQ(3, array->elements.size())
+				<< "array does not contain 3 elements, got=" << std::to_string(array->elements.size());
+
+			test_integer_literal(array->elements[0], 1);
+			EXPECT_EQ("(2 * 2)", array->elements[1]->string());
+			EXPECT_EQ("(3 + 3)", array->elements[2]->string());
+		}
+		else
+		{
+			EXPECT_TRUE(false) << "expression not ArrayLiteral";
+		}
+	}
+	else
+	{
+		EXPECT_TRUE(false) << "stmnt not ExpressionStatement";
+	}
+}
+
+TEST(ParserTest, TestEmptyArrayLiteral)
+{
+	interp::lexer::Lexer lex("[]");
+	interp::parser::Parser parse(lex);
+
+	auto prog = parse.parse_program();
+	check_parser_errors(parse);
+
+	ASSERT_EQ(1, prog->statements.size())
+		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
+
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
+	{
+		if (interp::ast::ArrayLiteral* array = dynamic_cast<interp::ast::ArrayLiteral*>(expstmnt->expression))
+		{
+			ASSERT_EQ(0, array->elements.size())
+				<< "array does not contain 0 elements, got=" << std::to_string(array->elements.size());
+		}
+		else
+		{
+			EXPECT_TRUE(false) << "expression not ArrayLiteral";
+		}
+	}
+	else
+	{
+		EXPECT_TRUE(false) << "stmnt not ExpressionStatement";
+	}
+}
+
+TEST(ParserTest, TestIndexExpression)
+{
+	std::string input = "myArray[1 + 1]";
+
+	interp::lexer::Lexer lex(input);
+	interp::parser::Parser parse(lex);
+
+	auto prog = parse.parse_program();
+	check_parser_errors(parse);
+
+	ASSERT_EQ(1, prog->statements.size())
+		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
+
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
+	{
+		if (interp::ast::IndexExpression* indexExpr = dynamic_cast<interp::ast::IndexExpression*>(expstmnt->expression))
+		{
+			test_identifier(indexExpr->left, "myArray");
+			EXPECT_EQ("(1 + 1)", indexExpr->index->string());
+		}
+		else
+		{
+			EXPECT_TRUE(false) << "expression not IndexExpression";
+		}
+	}
+	else
+	{
+		EXPECT_TRUE(false) << "stmnt not ExpressionStatement";
+	}
+}
+
+TEST(ParserTest, TestHashLiteral)
+{
+	std::string input = R"({"one": 1, "two": 2, three: 0 + 3})";
+
+	interp::lexer::Lexer lex(input);
+	interp::parser::Parser parse(lex);
+
+	auto prog = parse.parse_program();
+	check_parser_errors(parse);
+
+	ASSERT_EQ(1, prog->statements.size())
+		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
+
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
+	{
+		if (interp::ast::HashLiteral* hash = dynamic_cast<interp::ast::HashLiteral*>(expstmnt->expression))
+		{
+			ASSERT_EQ(3, hash->pairs.size())
+				<< "hash does not contain 3 pairs, got=" << std::to_string(hash->pairs.size());
+
+			EXPECT_EQ("one", hash->pairs[0].first->string());
+			test_integer_literal(hash->pairs[0].second, 1);
+			EXPECT_EQ("two", hash->pairs[1].first->string());
+			test_integer_literal(hash->pairs[1].second, 2);
+			test_identifier(hash->pairs[2].first, "three");
+			EXPECT_EQ("(0 + 3)", hash->pairs[2].second->string());
+		}
+		else
+		{
+			EXPECT_TRUE(false) << "expression not HashLiteral";
+		}
+	}
+	else
+	{
+		EXPECT_TRUE(false) << "stmnt not ExpressionStatement";
+	}
+}
+
+TEST(ParserTest, TestHashOrBlock)
+{
+	// Braces hold a hash only when the first expression is followed by a colon
+	std::tuple<std::string, interp::ast::NodeType, std::string> expected[] = {
+		std::tuple("{:}", interp::ast::NodeType::HashLiteral, "{:}"),
+		std::tuple("{}", interp::ast::NodeType::BlockExpression, "{ }"),
+		std::tuple("{ 1 }", interp::ast::NodeType::BlockExpression, "{ 1 }"),
+		std::tuple("{ x; y }", interp::ast::NodeType::BlockExpression, "{ x y }"),
+		std::tuple("{ let x = 1; x }", interp::ast::NodeType::BlockExpression, "{ let x = 1; x }"),
+		std::tuple("{1: true}", interp::ast::NodeType::HashLiteral, "{1: true}"),
+		std::tuple("{1: 2}[1]", interp::ast::NodeType::IndexExpression, "({1: 2}[1])"),
+	};
+
+	for (auto& tt : expected)
+	{
+		interp::lexer::Lexer lex(std::get<0>(tt));
+		interp::parser::Parser parse(lex);
+
+		auto prog = parse.parse_program();
+		check_parser_errors(parse);
+
+		ASSERT_EQ(1, prog->statements.size())
+			<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
+
+		auto expstmnt = static_cast<interp::ast::ExpressionStatement*>(prog->statements[0]);
+		EXPECT_EQ(std::get<1>(tt), expstmnt->expression->type()) << "Failed for: " << std::get<0>(tt);
+		EXPECT_EQ(std::get<2>(tt), expstmnt->expression->string()) << "Failed for: " << std::get<0>(tt);
+	}
+}
+
+TEST(ParserTest, TestLoopExpressions)
+{
+	// A loop body is a block even when it could be read as a hash
+	std::tuple<std::string, interp::ast::NodeType, std::string> expected[] = {
+		std::tuple("while (x < 10) { x = x + 1 }", interp::ast::NodeType::WhileExpression, "while (x < 10) { (x = (x + 1)) }"),
+		std::tuple("while (true) {}", interp::ast::NodeType::WhileExpression, "while true { }"),
+		std::tuple("for (x in [1, 2]) { let y = x; y }", interp::ast::NodeType::ForExpression, "for x in [1, 2] { let y = x; y }"),
+		std::tuple("for (x in xs) { x }", interp::ast::NodeType::ForExpression, "for x in xs { x }"),
+	};
+
+	for (auto& tt : expected)
+	{
+		interp::lexer::Lexer lex(std::get<0>(tt));
+		interp::parser::Parser parse(lex);
+
+		auto prog = parse.parse_program();
+		check_parser_errors(parse);
+
+		ASSERT_EQ(1, prog->statements.size())
+			<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
+
+		auto expstmnt = static_cast<interp::ast::ExpressionStatement*>(prog->statements[0]);
+		EXPECT_EQ(std::get<1>(tt), expstmnt->expression->type()) << "Failed for: " << std::get<0>(tt);
+		EXPECT_EQ(std::get<2>(tt), expstmnt->expression->string()) << "Failed for: " << std::get<0>(tt);
+	}
+}
+
+TEST(ParserTest, TestAssignToNonIdentifier)
+{
+	interp::lexer::Lexer lex("1 + x = 2");
+	interp::parser::Parser parse(lex);
+
+	parse.parse_program();
+	auto errors = parse.get_errors();
+
+	ASSERT_FALSE(errors.empty()) << "parser has no errors";
+	EXPECT_EQ("cannot assign to (1 + x)", errors[0]);
+}
+
 TEST(ParserTest, TestCallTwoParams)
 {
 	std::string input = "adder(x, y)";
@@ -804,9 +1014,9 @@ TEST(ParserTest, TestCallTwoParams)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::CallExpression* callExpr = dynamic_cast<interp::ast::CallExpression*>(expstmnt->expression.get()))
+		if (interp::ast::CallExpression* callExpr = dynamic_cast<interp::ast::CallExpression*>(expstmnt->expression))
 		{
 			test_identifier(callExpr->function, "adder");
 
@@ -840,9 +1050,9 @@ TEST(ParserTest, TestCallNoParams)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::CallExpression* callExpr = dynamic_cast<interp::ast::CallExpression*>(expstmnt->expression.get()))
+		if (interp::ast::CallExpression* callExpr = dynamic_cast<interp::ast::CallExpression*>(expstmnt->expression))
 		{
 			test_identifier(callExpr->function, "adder");
 
@@ -873,11 +1083,11 @@ TEST(ParserTest, TestCallOneParam)
 	ASSERT_EQ(1, prog->statements.size())
 		<< "program.Statements does not contain 1 statements. got=" << std::to_string(prog->statements.size());
 
-	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0].get()))
+	if (interp::ast::ExpressionStatement* expstmnt = dynamic_cast<interp::ast::ExpressionStatement*>(prog->statements[0]))
 	{
-		if (interp::ast::CallExpression* callExpr = dynamic_cast<interp::ast::CallExpression*>(expstmnt->expression.get()))
+		if (interp::ast::CallExpression* callExpr = dynamic_cast<interp::ast::CallExpression*>(expstmnt->expression))
 		{
-			if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(callExpr->function.get()))
+			if (interp::ast::FunctionLiteral* fnLit = dynamic_cast<interp::ast::FunctionLiteral*>(callExpr->function))
 			{
 				ASSERT_EQ(1, fnLit->params.size())
 					<< "fn params does not contain 1 identifiers, got=" << std::to_string(fnLit->params.size());
@@ -885,7 +1095,7 @@ TEST(ParserTest, TestCallOneParam)
 				test_identifier(fnLit->params[0], "x");
 
 
-				if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body.get()))
+				if (interp::ast::InfixExpression* fnStmnt = dynamic_cast<interp::ast::InfixExpression*>(fnLit->body))
 				{
 					test_identifier(fnStmnt->left, "x");
 
@@ -935,11 +1145,11 @@ void check_parser_errors(interp::parser::Parser p)
 	ASSERT_TRUE(false);
 }
 
-void test_let_statment(std::shared_ptr<interp::ast::Statement> stmnt, std::string name)
+void test_let_statment(interp::ast::Statement* stmnt, std::string name)
 {
 	ASSERT_EQ("let", stmnt->token_literal()) << "stmnt literal not 'let'. got=" << stmnt->token_literal();
 
-	if (interp::ast::LetStatement *letstmnt = dynamic_cast<interp::ast::LetStatement *>(stmnt.get()))
+	if (interp::ast::LetStatement *letstmnt = dynamic_cast<interp::ast::LetStatement *>(stmnt))
 	{
 		ASSERT_EQ(name, letstmnt->name.value) << "name not " << name << " got " << letstmnt->name.value;
 		ASSERT_EQ(name, letstmnt->name.token_literal()) << "name.token_literal not " << name << " got " << letstmnt->name.token_literal();
@@ -950,9 +1160,9 @@ void test_let_statment(std::shared_ptr<interp::ast::Statement> stmnt, std::strin
 	}
 }
 
-void test_integer_literal(std::shared_ptr<interp::ast::Expression> expr, int64_t value)
+void test_integer_literal(interp::ast::Expression* expr, int64_t value)
 {
-	if (interp::ast::IntegerLiteral* intlit = dynamic_cast<interp::ast::IntegerLiteral*>(expr.get()))
+	if (interp::ast::IntegerLiteral* intlit = dynamic_cast<interp::ast::IntegerLiteral*>(expr))
 	{
 
 		EXPECT_EQ(value, intlit->value) << "value not " << value << " got " << intlit->value;
@@ -963,9 +1173,9 @@ void test_integer_literal(std::shared_ptr<interp::ast::Expression> expr, int64_t
 	}
 }
 
-void test_identifier(std::shared_ptr<interp::ast::Expression> expr, std::string value)
+void test_identifier(interp::ast::Expression* expr, std::string value)
 {
-	if (interp::ast::Identifier* ident = dynamic_cast<interp::ast::Identifier*>(expr.get()))
+	if (interp::ast::Identifier* ident = dynamic_cast<interp::ast::Identifier*>(expr))
 	{
 		EXPECT_EQ(value, ident->value) << "value not " << value << " got " << ident->value;
 		EXPECT_EQ(value, ident->token_literal()) << "token literal not " << value << " got " << ident->token_literal();
@@ -976,9 +1186,9 @@ void test_identifier(std::shared_ptr<interp::ast::Expression> expr, std::string
 	}
 }
 
-void test_boolean(std::shared_ptr<interp::ast::Expression> expr, bool value)
+void test_boolean(interp::ast::Expression* expr, bool value)
 {
-	if (interp::ast::BooleanLiteral* boolean = dynamic_cast<interp::ast::BooleanLiteral*>(expr.get()))
+	if (interp::ast::BooleanLiteral* boolean = dynamic_cast<interp::ast::BooleanLiteral*>(expr))
 	{
 		EXPECT_EQ(value, boolean->value) << "value not " << value << " got " << boolean->value;
 		EXPECT_EQ(value ? "true" : "false", boolean->token_literal()) 